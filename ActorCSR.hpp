@@ -0,0 +1,116 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct ActorCSR, the compressed-sparse-row adjacency of the graph.
+ **/
+
+#ifndef ACTOR_CSR_HPP
+#define ACTOR_CSR_HPP
+
+#include <vector>
+
+#include "MappedArray.hpp"
+
+/** Consecutive rows of the CSR adjacency, built apart from it (by a thread
+ *  of a parallel build) and appended to it in order.
+ */
+struct CSRRows {
+  std::vector< int >  m_rowEnds;    //! End of each row in the arrays below
+  std::vector< int >  m_neighbors;  //! Neighbor indices of the rows
+  std::vector< int >  m_weights;    //! Edge-weights (parallel to m_neighbors)
+  std::vector< int >  m_movies;     //! Movie-id on edge (parallel to m_neighbors)
+};
+
+/** Compressed-sparse-row adjacency of the actor graph. Neighbors of actor i
+ *  occupy m_neighbors[m_offsets[i] .. m_offsets[i + 1]), and the weight and
+ *  movie of each edge sit at the same position in the parallel arrays.
+ */
+struct ActorCSR {
+  MappedArray< int >  m_offsets;    //! Row offsets (size: actors + 1)
+  MappedArray< int >  m_neighbors;  //! Neighbor indices of all rows
+  MappedArray< int >  m_weights;    //! Edge-weights (parallel to m_neighbors)
+  MappedArray< int >  m_movies;     //! Movie-id on edge (parallel to m_neighbors)
+
+  //! Number of directed edges stored
+  size_t numEdges() const {
+    return m_neighbors.size();
+  }
+
+  //! Number of actors (rows)
+  int numNodes() const {
+    return m_offsets.empty() ? 0 : (int) m_offsets.size() - 1;
+  }
+
+  //! Number of neighbors of an actor
+  int degree( const int &i_node ) const {
+    return m_offsets[i_node + 1] - m_offsets[i_node];
+  }
+
+  //! Call i_visit on each neighbor of an actor (and the edge's position) until it returns true
+  template< class Visit >
+  bool scan( const int   &i_node,
+                   Visit  i_visit ) const {
+    for( int l_e = m_offsets[i_node]; l_e < m_offsets[i_node + 1]; ++l_e )
+      if( i_visit( m_neighbors[l_e], l_e ) )
+        return true;
+
+    return false;
+  }
+
+  //! Append rows after the last one and free them (starts the offsets if there are none;
+  //! the total of edges must fit in an int)
+  void append( CSRRows &io_rows ) {
+    int l_base = (int) m_neighbors.size();
+
+    if( m_offsets.empty() )
+      m_offsets.push_back( 0 );
+
+    for( int l_end : io_rows.m_rowEnds )
+      m_offsets.push_back( l_base + l_end );
+
+    if( m_neighbors.empty() ) {
+      //! First rows are taken over rather than copied
+      m_neighbors.adopt( io_rows.m_neighbors );
+      m_weights.adopt( io_rows.m_weights );
+      m_movies.adopt( io_rows.m_movies );
+    } else {
+      m_neighbors.append( io_rows.m_neighbors.data(), io_rows.m_neighbors.size() );
+      m_weights.append( io_rows.m_weights.data(), io_rows.m_weights.size() );
+      m_movies.append( io_rows.m_movies.data(), io_rows.m_movies.size() );
+    }
+
+    io_rows = CSRRows();
+  }
+
+  //! Bytes held by the arrays
+  size_t bytes() const {
+    return (m_offsets.size() + m_neighbors.size() +
+            m_weights.size() + m_movies.size()) * sizeof( int );
+  }
+};
+
+#endif //! ACTOR_CSR_HPP
@@ -37,7 +37,7 @@
 //! Edge in graph representing a movie between 2 actors
 struct Edge {
   int         m_weight;   //! Edge-weight
-  std::string m_movie;    //! Movie-title
+  int         m_movie;    //! Movie-id
 };
 
 #endif //! ACTOREDGE_H
\ No newline at end of file
@@ -30,19 +30,40 @@
  **/
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 #include "ActorGraph.h"
+#include "CastLoader.h"
+
+//! Pairs planned and searched at a time (their paths are held until written out)
+static const size_t g_queryChunk = 1 << 18;
+
+//! Actors formatted at a time by a thread writing the hub table
+static const size_t g_tableBlock = 1 << 12;
+
+//! Chunks of actors per thread building the CSR adjacency (evens out their work)
+static const int g_buildChunks = 8;
 
 /** Input params: First line to output in file, use weighted edges or not
  *  Return param: None
  *  Description : Constructor
  *
- *  Populates outLines with first line to output (eg: Actor1	Actor2	Year).
+ *  Keeps the first line to output (eg: Actor1	Actor2	Year); with ids, a
+ *  path's line lists actor, movie, actor, ... ids separated by tabs.
  */
 ActorGraph::ActorGraph( const std::string &i_outLine,
-                        const std::string &i_uwe ) : m_useWeightedEdges(i_uwe) {
-  m_outLines.push_back( i_outLine );
-}
+                        const std::string &i_uwe ) : m_useWeightedEdges(i_uwe),
+                                                     m_bipartite(false),
+                                                     m_search(""),
+                                                     m_minWeight(0),
+                                                     m_maxWeight(0),
+                                                     m_header(i_outLine),
+                                                     m_idHeader("actor\tmovie\tactor\t..."),
+                                                     m_idOutput(false),
+                                                     m_builtCSR(false) {}
 
 /** Input params: None
  *  Return param: None
@@ -54,348 +75,1334 @@ ActorGraph::~ActorGraph() {
   deleteGraph();
 }
 
-/** Input params: Boolean stating whether to create edges between actors
+/** Input params: Boolean flag
+ *  Return param: None
+ *  Description : Selects the graph mode
+ *
+ *  When set, createGraph builds the actor-movie graph and the traversals
+ *  expand movies instead of the co-star cliques.
+ */
+void ActorGraph::useBipartite( const bool &i_flag ) {
+  m_bipartite = i_flag;
+}
+
+/** Input params: Name of the search algorithm
+ *  Return param: None
+ *  Description : Selects the search algorithm
+ *
+ *  "bidir" searches unweighted co-star paths from both ends, "dobfs" with the
+ *  direction-optimizing BFS, "dijkstra" weighted paths with a binary heap
+ *  instead of Dial's buckets and "astar" either with A* over landmark bounds
+ *  (see buildLandmarks); an empty name keeps the default traversal of the
+ *  mode.
+ */
+void ActorGraph::useSearch( const std::string &i_search ) {
+  m_search = i_search;
+}
+
+/** Input params: Most paths kept (0 for none)
  *  Return param: None
+ *  Description : Selects the path cache
+ *
+ *  Paths of up to i_capacity recent pairs are kept and reused for repeated
+ *  pairs. Unweighted paths are shortest either way, so in that mode a pair
+ *  and its reverse share one cached path.
+ */
+void ActorGraph::useCache( const size_t &i_capacity ) {
+  m_cache.init( i_capacity, m_useWeightedEdges == "u" );
+}
+
+/** Input params: Boolean stating whether to create edges between actors,
+ *                thread count
+ *  Return param: Boolean
  *  Description : Creates the graph
  *
- *  Creates actor nodes, initilizes them and populates the adjacency list
- *  depending on input boolean flag.
+ *  Creates actor nodes, initilizes them and populates the CSR adjacency
+ *  depending on input boolean flag (unless a snapshot already provided it)
+ *  on i_threads threads (0 for all hardware threads). Fails if the
+ *  adjacency has more edges than its int offsets can index.
  */
-void ActorGraph::createGraph( const bool &i_createEdges ) {
+bool ActorGraph::createGraph( const bool &i_createEdges,
+                              const int  &i_threads ) {
   Actor *l_act;
+  int    l_numActors = m_actorNames.size();
+  bool   l_buildCSR  = i_createEdges && !m_bipartite && m_csr.m_offsets.empty();
+
+  //! Range of the edge-weights (sizes the buckets of Djikstra's traversal)
+  m_minWeight = std::numeric_limits< int >::max();
+  m_maxWeight = 0;
+  for( int l_movie = 0; l_movie < m_movieTable.size(); ++l_movie ) {
+    int l_weight = (m_useWeightedEdges == "u") ? 1 : 1 + (2015 - m_movieTable.m_years[l_movie]);
 
-  for( m_moa = m_moviesOfActor.begin(); m_moa != m_moviesOfActor.end(); ++m_moa ) {
-    l_act           = new Actor;                            //! New vertex in graph
-    m_ioa           = m_indexOfActor.find( m_moa->first );  //! Get global actor index
-    l_act->m_index  = m_ioa->second;                        //! Set index
-    l_act->m_dist   = std::numeric_limits< int >::max();    //! Set distance to infinity
-    l_act->m_prev   = -1;                                   //! Set previous to null
-    l_act->m_done   = false;                                //! Set done to false
+    m_minWeight = std::min( m_minWeight, l_weight );
+    m_maxWeight = std::max( m_maxWeight, l_weight );
+  }
 
-    if( i_createEdges )
-      findNeighbors( m_moa->first, l_act->m_adj );          //! Populate edge-weights
+  for( int l_index = 0; l_index < l_numActors; ++l_index ) {
+    l_act           = m_actorPool.create();                 //! New vertex in graph
+    l_act->m_index  = l_index;                              //! Set index
 
     m_theGraph.push_back( l_act );                          //! Push vertex to graph
   }
+
+  if( l_buildCSR && !buildCSR( i_threads ) )              //! Populate edge-weights
+    return false;
+
+  m_builtCSR = l_buildCSR;
+
+  if( i_createEdges && m_bipartite ) {
+    createBipartite();
+    std::cout << "Graph: " << m_theGraph.size() << " actors, " << m_bip.numMovies()
+              << " movies, " << m_bip.numCredits() << " credits, "
+              << m_bip.bytes() / (1024.0 * 1024.0) << " MB adjacency\n";
+  } else if( i_createEdges )
+    std::cout << "Graph: " << m_theGraph.size() << " actors, " << m_csr.numEdges()
+              << " edges, " << m_csr.bytes() / (1024.0 * 1024.0) << " MB adjacency"
+              << (m_csr.m_offsets.isMapped() ? " (mapped)" : "") << "\n";
+
+  return true;
 }
 
 /** Input params: None
  *  Return param: None
- *  Description : Deletes the graph
+ *  Description : Prepares the actor-movie graph
  *
- *  Deallocates memory from nodes (Actor) and edges (Edge)
+ *  The cast and filmography arrays exist since load; only the edge-weight
+ *  through each movie depends on weighted/unweighted edges.
  */
-void ActorGraph::deleteGraph() {
-  //! Memory deallocation
-  for( m_ait = m_theGraph.begin(); m_ait != m_theGraph.end(); ++m_ait ) {
-    for( m_eit = (*m_ait)->m_adj.begin(); m_eit != (*m_ait)->m_adj.end(); ++m_eit )
-      delete (*m_eit).second;   //! Deallocate Edges
+void ActorGraph::createBipartite() {
+  m_bip.m_movieWeights.clear();
+  m_bip.m_movieWeights.reserve( m_movieTable.size() );
 
-    delete *m_ait;  //! Deallocate Actors
+  for( int l_movie = 0; l_movie < m_movieTable.size(); ++l_movie ) {
+    if( m_useWeightedEdges == "u" )
+      m_bip.m_movieWeights.push_back( 1 );
+    else
+      m_bip.m_movieWeights.push_back( 1 + (2015 - m_movieTable.m_years[l_movie]) );
   }
 }
 
-/** Input params: Movie
- *  Return param: Year
- *  Description : Extract year (last 4 digits) from movie title
+/** Input params: None
+ *  Return param: None
+ *  Description : Deletes the graph
  *
- *  Movie title is of form: Movie#@year (eg: INCEPTION#@2010).
+ *  Destroys the nodes (Actor) and edges (Edge) in bulk; their pools free the
+ *  memory when the graph goes.
  */
-int ActorGraph::extractYear( const std::string &i_movie ) {
-  size_t l_pos;       //! String position tracker
-  std::string l_year; //! String to hold year extracted from last 4 places of movie
+void ActorGraph::deleteGraph() {
+  m_theGraph.clear();
+  m_actorPool.clear();
+  m_edgePool.clear();
+}
 
-  l_pos   = i_movie.find( "#@" );
-  l_pos   += 2;
-  l_year  = i_movie.substr( l_pos );
+/** Input params: Edge an actor was reached through (as recorded in the state)
+ *  Return param: Movie-id on the edge (-1 if none)
+ *  Description : Finds a movie edge
+ *
+ *  Edges are recorded as positions in the CSR rows, or as the movie itself
+ *  in bipartite mode.
+ */
+int ActorGraph::movieOf( const int &i_edge ) const {
+  if( m_bipartite || i_edge == -1 )
+    return i_edge;
 
-  return std::stoi( l_year );
+  return m_csr.m_movies[i_edge];
 }
 
-/** Input params: Actor node and neighboring node's index
- *  Return param: Movie on the edge between the two actors
- *  Description : Finds a movie edge
+/** Input params: Thread count
+ *  Return param: Boolean
+ *  Description : Builds the CSR adjacency
+ *
+ *  Cuts the actors into chunks of about equal work (the casts of their
+ *  movies, which findNeighbors scans) in index order. Each thread builds the
+ *  rows of the chunks it picks up into rows of their own, with a slot array
+ *  of its own, and the chunks are appended in order once all are built, so
+ *  the adjacency is the same for any number of threads.
+ *
+ *  Offsets and row positions are ints, so the build stops (false) once a
+ *  chunk could grow past INT_MAX edges or all of them add up to more.
  */
-std::string ActorGraph::findMovieEdge(       Actor *i_node1,
-                                       const int   &i_index2 ) {
-  m_eit = i_node1->m_adj.find( i_index2 );  //! Find neighbor's index in adj list
+bool ActorGraph::buildCSR( const int &i_threads ) {
+  int l_numActors = m_actorNames.size();
+  int l_threads   = i_threads;
+
+  if( l_threads <= 0 )
+    l_threads = std::max( (int) std::thread::hardware_concurrency(), 1 );
+  l_threads = std::min( l_threads, std::max( l_numActors, 1 ) );
+
+  int l_numChunks = (l_threads == 1) ? 1 : l_threads * g_buildChunks;
+
+  //! Work before each actor (co-stars scanned, with repeats)
+  std::vector< long long > l_work( l_numActors + 1, 0 );
+  for( int l_index = 0; l_index < l_numActors; ++l_index ) {
+    l_work[l_index + 1] = l_work[l_index];
+    for( int l_m = m_bip.m_movieOffsets[l_index]; l_m < m_bip.m_movieOffsets[l_index + 1]; ++l_m )
+      l_work[l_index + 1] += m_bip.m_castOffsets[m_bip.m_movieIds[l_m] + 1] - m_bip.m_castOffsets[m_bip.m_movieIds[l_m]];
+  }
 
-  if( m_eit != i_node1->m_adj.end() )
-    return m_eit->second->m_movie;      //! Return movie stored on edge
-  else
-    return "";
+  //! First actor of each chunk
+  std::vector< int > l_first( l_numChunks + 1, l_numActors );
+  l_first[0] = 0;
+  for( int l_c = 1; l_c < l_numChunks; ++l_c )
+    l_first[l_c] = (int) (std::lower_bound( l_work.begin(), l_work.end(),
+                                            l_work[l_numActors] * l_c / l_numChunks ) - l_work.begin());
+
+  std::vector< CSRRows >     l_rows( l_numChunks );  //! Rows of each chunk
+  std::atomic< int >         l_nextChunk( 0 );       //! Next chunk to be picked up
+  std::atomic< bool >        l_tooMany( false );     //! Edges overflow the int offsets
+  std::vector< std::thread > l_pool;                 //! Worker threads
+
+  //! Each thread builds the rows of the chunks it picks up
+  auto l_worker = [&]() {
+    std::vector< int > l_slot( l_numActors, -1 );   //! Row position of each neighbor
+
+    for( int l_c = l_nextChunk++; l_c < l_numChunks && !l_tooMany; l_c = l_nextChunk++ ) {
+      CSRRows &l_chunk = l_rows[l_c];
+
+      for( int l_index = l_first[l_c]; l_index < l_first[l_c + 1]; ++l_index ) {
+        //! The actor's work bounds the length of its row
+        if( (long long) l_chunk.m_neighbors.size() + l_work[l_index + 1] - l_work[l_index] >
+            std::numeric_limits< int >::max() ) {
+          l_tooMany = true;
+          break;
+        }
+
+        findNeighbors( l_index, l_slot, l_chunk );
+      }
+
+      //! Drop the slack of the chunk while the others are built
+      if( l_numChunks > 1 ) {
+        l_chunk.m_neighbors.shrink_to_fit();
+        l_chunk.m_weights.shrink_to_fit();
+        l_chunk.m_movies.shrink_to_fit();
+      }
+    }
+  };
+
+  for( int l_t = 1; l_t < l_threads; ++l_t )
+    l_pool.push_back( std::thread( l_worker ) );
+
+  l_worker();   //! The calling thread works too
+
+  for( std::thread &l_thread : l_pool )
+    l_thread.join();
+
+  //! Size the first chunk (taken over by m_csr) for all edges so appending does not regrow it
+  size_t l_numEdges = 0;
+  for( const CSRRows &l_chunk : l_rows )
+    l_numEdges += l_chunk.m_neighbors.size();
+
+  if( l_tooMany || l_numEdges > (size_t) std::numeric_limits< int >::max() ) {
+    std::cerr << "Graph has more than " << std::numeric_limits< int >::max()
+              << " co-star edges, more than the CSR adjacency can index!\n";
+    return false;
+  }
+
+  l_rows[0].m_neighbors.reserve( l_numEdges );
+  l_rows[0].m_weights.reserve( l_numEdges );
+  l_rows[0].m_movies.reserve( l_numEdges );
+
+  for( CSRRows &l_chunk : l_rows )
+    m_csr.append( l_chunk );
+
+  return true;
 }
 
-/** Input params: Actor name and adjacency list (passed by reference)
+/** Input params: Actor index, neighbor slot array and rows being built
+ *                (passed by reference)
  *  Return param: None
  *  Description : Finds neighbors of an actor
  *
- *  Finds neighbor nodes, populates adjacency list with newly created edges
- *  for movies lying on them with their respective weights.
+ *  Finds neighbor nodes and appends them as the next row of io_rows along
+ *  with the movies lying on the edges and their respective weights. io_slot
+ *  maps a neighbor's index to its position in the row being built and is
+ *  reset to -1 for the row's neighbors before returning.
  */
-void ActorGraph::findNeighbors( const std::string &i_actor,
-                                      std::unordered_map< int, Edge * > &io_adjEdges ) {
+void ActorGraph::findNeighbors( const int                &i_actor,
+                                      std::vector< int > &io_slot,
+                                      CSRRows            &io_rows ) const {
+  int l_movie;    //! Movie-id
   int l_ind;      //! Index of neighbor
+  int l_pos;      //! Position of neighbor in the row
   int l_weight;   //! Edge-weight
+  int l_begin = (int) io_rows.m_neighbors.size();  //! Start of the row
 
-  //! Search for actor in respective hash-map
-  m_moa = m_moviesOfActor.find( i_actor );
-  if( m_moa != m_moviesOfActor.end() ) {
-    for( m_vit = (m_moa->second).begin(); m_vit != (m_moa->second).end(); ++m_vit ) {
-      m_aim = m_actorsInMovie.find( *m_vit );  //! *vit is movie
-
-      if( m_aim != m_actorsInMovie.end() ) {
-        for( m_sit = (m_aim->second).begin(); m_sit != (m_aim->second).end(); ++m_sit ) {
-          //! Skip self
-          if( i_actor.compare( *m_sit ) == 0 )  //! *sit is actor
-            continue;
-
-          //! Unweighted edges
-          if( m_useWeightedEdges == "u" ) {
-            l_weight = 1;
-
-            //! Get index of neighbor and search in adjacency list
-            m_ioa = m_indexOfActor.find( *m_sit );
-            l_ind = m_ioa->second;
-            m_eit = io_adjEdges.find( l_ind );
-
-            if( m_eit != io_adjEdges.end() )
-              continue;
-            else {
-              Edge *l_ed          = new Edge;
-              l_ed->m_movie       = *m_vit;
-              l_ed->m_weight      = l_weight;
-              io_adjEdges[l_ind]  = l_ed;
-            }
-          }
+  for( int l_m = m_bip.m_movieOffsets[i_actor]; l_m < m_bip.m_movieOffsets[i_actor + 1]; ++l_m ) {
+    l_movie = m_bip.m_movieIds[l_m];
 
-          //! Weighted edges
-          else {
-            l_weight  = 1 + (2015 - extractYear( *m_vit ));   //! Weight-formula
-
-            //! Get index of neighbor and search in adjacency list
-            m_ioa = m_indexOfActor.find( *m_sit );
-            l_ind = m_ioa->second;
-            m_eit = io_adjEdges.find( l_ind );
-
-            if( m_eit != io_adjEdges.end() ) {
-              if( l_weight < m_eit->second->m_weight ) {
-                //! Update edge with newer movies having lesser weights
-                m_eit->second->m_weight = l_weight;
-                m_eit->second->m_movie  = *m_vit;
-              }
-            } else {
-              //! Construct new edge with edge info
-              Edge *l_ed          = new Edge;
-              l_ed->m_movie       = *m_vit;
-              l_ed->m_weight      = l_weight;
-              io_adjEdges[l_ind]  = l_ed;
-            }
-          }
-        }
+    //! Unweighted edges weigh 1, weighted ones use the weight-formula
+    if( m_useWeightedEdges == "u" )
+      l_weight = 1;
+    else
+      l_weight = 1 + (2015 - m_movieTable.m_years[l_movie]);
+
+    for( int l_c = m_bip.m_castOffsets[l_movie]; l_c < m_bip.m_castOffsets[l_movie + 1]; ++l_c ) {
+      l_ind = m_bip.m_castIds[l_c];
+
+      //! Skip self
+      if( l_ind == i_actor )
+        continue;
+
+      //! Get position of neighbor in the row
+      l_pos = io_slot[l_ind];
+
+      if( l_pos == -1 ) {
+        //! Construct new edge with edge info
+        io_slot[l_ind] = (int) io_rows.m_neighbors.size();
+        io_rows.m_neighbors.push_back( l_ind );
+        io_rows.m_weights.push_back( l_weight );
+        io_rows.m_movies.push_back( l_movie );
+      } else if( l_weight < io_rows.m_weights[l_pos] ) {
+        //! Update edge with newer movies having lesser weights
+        io_rows.m_weights[l_pos] = l_weight;
+        io_rows.m_movies[l_pos]  = l_movie;
       }
     }
   }
+
+  io_rows.m_rowEnds.push_back( (int) io_rows.m_neighbors.size() );
+
+  //! Reset slots of this row for the next actor
+  for( int l_e = l_begin; l_e < (int) io_rows.m_neighbors.size(); ++l_e )
+    io_slot[io_rows.m_neighbors[l_e]] = -1;
 }
 
-/** Input params: Index in the graph to traverse from and to
+/** Input params: Initial and end node of a successful traversal, its state
+ *                and path (passed by reference)
  *  Return param: None
- *  Description : BFS Traversal
+ *  Description : Traces path
  *
- *  Performs BFS traversal between 2 nodes and if successful, stores the path
- *  information (actors & movies) in a particular format to outLines to later
- *  write out to the output file.
+ *  Walks the previous-actor links back from the end node, recording the ids
+ *  of the actors and the movies of the edges they were reached through, and
+ *  turns them around so the path reads from the initial node.
  */
-void ActorGraph::BFSTraverse( const int &i_from,
-                              const int &i_to ) {
-  std::queue< Actor * >  l_toExplore;   //! Queue to explore
-  std::vector< Actor * > l_visited;     //! Visited nodes during traversal
+void ActorGraph::tracePath( const int                &i_from,
+                            const int                &i_to,
+                            const TraversalState     &i_state,
+                                  std::vector< int > &o_path ) const {
+  o_path.clear();
+  o_path.push_back( i_to );
+
+  for( int l_curr = i_to; l_curr != i_from; l_curr = i_state.prev( l_curr ) ) {
+    o_path.push_back( movieOf( i_state.via( l_curr ) ) );
+    o_path.push_back( i_state.prev( l_curr ) );
+  }
 
-  Actor *l_next, *l_neighbor;           //! Actor nodes
-  bool l_found    = false;              //! Flag stating success of traversal
+  std::reverse( o_path.begin(), o_path.end() );
+}
+
+/** Input params: Traced path, line to append to (passed by reference)
+ *  Return param: None
+ *  Description : Formats path
+ *
+ *  Appends the path information (actors & movies) straight into the line, in
+ *  the output format (or as tab-separated ids).
+ */
+void ActorGraph::formatPath( const std::vector< int > &i_path,
+                                   std::string        &io_line ) const {
+  for( size_t l_k = 0; l_k < i_path.size(); ++l_k ) {
+    int l_id = i_path[l_k];   //! Actor at even positions, movie at odd ones
+
+    if( m_idOutput ) {
+      if( l_k > 0 )
+        io_line += '\t';
+
+      io_line += std::to_string( l_id );
+    } else if( l_k % 2 == 0 ) {
+      io_line += '(';
+      io_line.append( m_actorNames.data( l_id ), m_actorNames.length( l_id ) );
+      io_line += ')';
+    } else {
+      io_line += "--[";
+      if( l_id != -1 )
+        io_line.append( m_movieTable.m_names.data( l_id ), m_movieTable.m_names.length( l_id ) );
+      io_line += "]-->";
+    }
+  }
+}
 
-  Actor *l_start  = m_theGraph[i_from]; //! Initial node
-  Actor *l_end    = m_theGraph[i_to];   //! End node
+/** Input params: Index in the graph to traverse from, traversal state
+ *  Return param: Boolean stating whether all targets were reached
+ *  Description : BFS Traversal
+ *
+ *  Performs BFS traversal from a node until every target marked in the state
+ *  is reached, recording distances and previous actors in the state (reset by
+ *  the caller once the paths are read).
+ */
+bool ActorGraph::BFSTraverse( const int            &i_from,
+                                    TraversalState &io_state ) const {
+  std::queue< int > l_toExplore;        //! Queue to explore
+  int l_next, l_neighbor;               //! Actor indices
+  int l_dist;                           //! Distance of the next level
+  uint64_t l_key;                       //! Its key in the state
 
   //! Intial node conditioning
-  l_start->m_dist   = 0;
-  l_toExplore.push( l_start );
-  l_visited.push_back( l_start );
+  io_state.visit( i_from, 0, -1 );
+  l_toExplore.push( i_from );
 
   //! Traverse till queue isn't empty
   while( !l_toExplore.empty() ) {
     //! Get front element from queue
     l_next  = l_toExplore.front();
     l_toExplore.pop();
+    ++io_state.m_stats.m_popped;
 
-    //! Break if traverse was successful
-    if( l_next == l_end ) {
-      l_found = true;
-      break;
-    }
+    //! Return once the last target is reached
+    if( io_state.settle( l_next ) )
+      return true;
+
+    io_state.m_stats.m_scanned += m_csr.m_offsets[l_next + 1] - m_csr.m_offsets[l_next];
+    l_dist = io_state.dist( l_next ) + 1;
+    l_key  = io_state.key( l_dist );
 
     //! Breadth-first search algorithm
-    for( m_eit = l_next->m_adj.begin(); m_eit != l_next->m_adj.end(); ++m_eit ) {
-      l_neighbor  = m_theGraph[m_eit->first];
+    for( int l_e = m_csr.m_offsets[l_next]; l_e < m_csr.m_offsets[l_next + 1]; ++l_e ) {
+      l_neighbor  = m_csr.m_neighbors[l_e];
 
-      if( (l_next->m_dist + 1) < l_neighbor->m_dist ) {
-        l_neighbor->m_dist  = l_next->m_dist + 1;
-        l_neighbor->m_prev  = l_next->m_index;
+      if( io_state.improves( l_neighbor, l_key ) ) {
+        io_state.visit( l_neighbor, l_dist, l_next, l_e );
         l_toExplore.push( l_neighbor );
-        l_visited.push_back( l_neighbor );
+        ++io_state.m_stats.m_pushes;
       }
     }
   }
 
-  //! For successful traversals, store path information (movies and actors)
-  if( l_found ) {
-    int l_prevInd;
-    std::vector< std::string > l_output;
-    std::string l_actor, l_movie, l_result;
-
-    Actor *l_curr = m_theGraph[l_end->m_prev];
+  return false;
+}
 
-    m_aai     = m_actorAtIndex.find( l_end->m_index );
-    l_actor   = "(" + m_aai->second + ")";
-    l_prevInd = l_end->m_index;
-    l_output.push_back( l_actor );
+/** Input params: Index in the graph to traverse from and to, traversal state
+ *  Return param: Boolean stating success of traversal
+ *  Description : Bidirectional BFS Traversal
+ *
+ *  Grows one BFS level at a time from both ends, always expanding the smaller
+ *  frontier. The level in which the two searches first meet is finished and
+ *  the meeting actor on the shortest path is picked; the target's half of the
+ *  path is then linked into the previous-actor info so the path reads as if
+ *  found by BFSTraverse.
+ */
+bool ActorGraph::bidirectionalBFSTraverse( const int            &i_from,
+                                           const int            &i_to,
+                                                 TraversalState &io_state ) const {
+  std::vector< int > l_front, l_back;   //! Current level of either search
+  std::vector< int > l_nextLevel;       //! Level being discovered
+  int l_neighbor;                       //! Actor index
+  int l_meet  = -1;                     //! Actor where the searches meet
+  int l_best  = std::numeric_limits< int >::max();  //! Length of path through l_meet
 
-    while( l_curr != l_start ) {
-      l_movie   = "--[" + findMovieEdge( l_curr, l_prevInd ) + "]-->";
-      l_output.push_back( l_movie );
+  //! Intial node conditioning
+  io_state.visit( i_from, 0, -1 );
+  io_state.visitBack( i_to, 0, -1 );
+  l_front.push_back( i_from );
+  l_back.push_back( i_to );
+
+  if( i_from == i_to )
+    return true;
+
+  //! Traverse till either search runs out of actors or they meet
+  while( !l_front.empty() && !l_back.empty() && l_meet == -1 ) {
+    bool l_forward = l_front.size() <= l_back.size();
+    std::vector< int > &l_level = l_forward ? l_front : l_back;
+
+    l_nextLevel.clear();
+
+    for( int l_next : l_level ) {
+      ++io_state.m_stats.m_popped;
+      io_state.m_stats.m_scanned += m_csr.m_offsets[l_next + 1] - m_csr.m_offsets[l_next];
+
+      for( int l_e = m_csr.m_offsets[l_next]; l_e < m_csr.m_offsets[l_next + 1]; ++l_e ) {
+        l_neighbor  = m_csr.m_neighbors[l_e];
+
+        if( l_forward && io_state.dist( l_neighbor ) == std::numeric_limits< int >::max() ) {
+          io_state.visit( l_neighbor, io_state.dist( l_next ) + 1, l_next, l_e );
+          l_nextLevel.push_back( l_neighbor );
+        } else if( !l_forward && io_state.distBack( l_neighbor ) == std::numeric_limits< int >::max() ) {
+          io_state.visitBack( l_neighbor, io_state.distBack( l_next ) + 1, l_next, l_e );
+          l_nextLevel.push_back( l_neighbor );
+        } else
+          continue;
+
+        //! Reached by the other search as well
+        if( io_state.dist( l_neighbor ) != std::numeric_limits< int >::max() &&
+            io_state.distBack( l_neighbor ) != std::numeric_limits< int >::max() &&
+            io_state.dist( l_neighbor ) + io_state.distBack( l_neighbor ) < l_best ) {
+          l_best  = io_state.dist( l_neighbor ) + io_state.distBack( l_neighbor );
+          l_meet  = l_neighbor;
+        }
+      }
+    }
 
-      m_aai     = m_actorAtIndex.find( l_curr->m_index );
-      l_actor   = "(" + m_aai->second + ")";
-      l_output.push_back( l_actor );
+    io_state.m_stats.m_pushes += (long long) l_nextLevel.size();
+    l_level.swap( l_nextLevel );
+  }
 
-      l_prevInd = l_curr->m_index;
-      l_curr    = m_theGraph[l_curr->m_prev];
-    }
+  if( l_meet == -1 )
+    return false;
 
-    l_movie = "--[" + findMovieEdge( l_start, l_prevInd ) + "]-->";
-    l_output.push_back( l_movie );
+  //! Link the target's half of the path behind the meeting actor
+  for( int l_curr = l_meet; l_curr != i_to; l_curr = io_state.m_next[l_curr] ) {
+    io_state.m_prev[io_state.m_next[l_curr]] = l_curr;
+    io_state.m_via[io_state.m_next[l_curr]]  = io_state.m_viaBack[l_curr];
+  }
 
-    m_aai   = m_actorAtIndex.find( l_start->m_index );
-    l_actor = "(" + m_aai->second + ")";
-    l_output.push_back( l_actor );
+  return true;
+}
 
-    std::reverse( l_output.begin(), l_output.end() );
+/** Input params: Index in the graph to traverse from and to, traversal state
+ *  Return param: Boolean stating success of traversal
+ *  Description : Direction-optimizing BFS Traversal
+ *
+ *  Runs the bitmap BFS of DirectionBFS over the CSR adjacency and copies the
+ *  previous-actor links and edges of the path found into the state.
+ */
+bool ActorGraph::directionBFSTraverse( const int            &i_from,
+                                       const int            &i_to,
+                                             TraversalState &io_state ) const {
+  bool l_found    = io_state.m_dobfs.search( m_csr, i_from, i_to );
 
-    for( std::string l_s : l_output )
-      l_result += l_s;
+  io_state.m_stats.m_popped  += io_state.m_dobfs.numExpanded();
+  io_state.m_stats.m_scanned += io_state.m_dobfs.numScanned();
+  io_state.m_stats.m_pushes  += io_state.m_dobfs.numVisited();
+  int  l_numPath  = 0;   //! Actors on the path
 
-    m_outLines.push_back( l_result ); //! Store output line to be written out later
+  if( l_found ) {
+    for( int l_curr = i_to; l_curr != -1; l_curr = io_state.m_dobfs.parent( l_curr ) ) {
+      io_state.visit( l_curr, 0, io_state.m_dobfs.parent( l_curr ), io_state.m_dobfs.parentEdge( l_curr ) );
+      ++l_numPath;
+    }
   }
 
-  //! Reset distances and previous info for all visited nodes during traversal
-  for( m_ait = l_visited.begin(); m_ait != l_visited.end(); ++m_ait ) {
-    (*m_ait)->m_dist = std::numeric_limits< int >::max();
-    (*m_ait)->m_prev = -1;
-  }
+  //! Count every actor the search visited, not only the path
+  io_state.m_numVisited += io_state.m_dobfs.numVisited() - l_numPath;
+
+  return l_found;
 }
 
-/** Input params: Index in the graph to traverse from and to
- *  Return param: None
+/** Input params: Index in the graph to traverse from, traversal state and
+ *                priority queue
+ *  Return param: Boolean stating whether all targets were settled
  *  Description : Djikstra's Traversal
  *
- *  Performs Djikstra's traversal between 2 nodes and if successful, stores the
- *  path information (actors & movies) in a particular format to outLines to
- *  later write out to the output file.
+ *  Performs Djikstra's traversal from a node until every target marked in the
+ *  state is settled (every reachable node without targets), recording
+ *  distances and previous actors in the state. Queue entries carry the
+ *  distance they were pushed with, so stale entries of improved nodes are
+ *  simply skipped. The queue is a HeapQueue or (for non-negative weights) a
+ *  BucketQueue.
  */
-void ActorGraph::DjikstraTraverse( const int &i_from,
-                                   const int &i_to ) {
-  //! Priority queue with custom comparator class (ActorComp)
-  std::priority_queue< Actor *, std::vector< Actor * >, ActorComp > l_toExplore;
-  std::vector< Actor * > l_visited;       //! Visited nodes
-
-  Actor *l_next, *l_neighbor;             //! Actor nodes
-  bool l_found    = false;                //! Flag stating success of traversal
+template< class Queue >
+bool ActorGraph::DjikstraTraverse( const int            &i_from,
+                                         TraversalState &io_state,
+                                         Queue          &io_toExplore ) const {
+  int l_next, l_neighbor;                 //! Actor indices
+  int l_dist;                             //! Distance an entry was pushed with
+  int l_base;                             //! Distance of the actor expanded
   int l_cost      = 0;                    //! Cost of traversal
+  uint64_t l_baseKey;                     //! Key of l_base in the state
+
+  //! Initial node conditioning
+  io_state.visit( i_from, 0, -1 );
+  io_toExplore.push( i_from, 0 );
+
+  //! Traverse till priority queue isn't empty
+  while( !io_toExplore.empty() ) {
+    //! Get top element of priority queue
+    io_toExplore.pop( l_next, l_dist );
+    ++io_state.m_stats.m_popped;
+
+    //! Djikstra's algorithm
+    if( !io_state.isDone( l_next ) ) {
+      io_state.markDone( l_next );
+
+      //! Return once the last target is settled
+      if( io_state.settle( l_next ) )
+        return true;
+
+      io_state.m_stats.m_scanned += m_csr.m_offsets[l_next + 1] - m_csr.m_offsets[l_next];
+
+      l_base    = io_state.dist( l_next );
+      l_baseKey = io_state.key( l_base );
+
+      for( int l_e = m_csr.m_offsets[l_next]; l_e < m_csr.m_offsets[l_next + 1]; ++l_e ) {
+        l_neighbor  = m_csr.m_neighbors[l_e];
+
+        if( io_state.improves( l_neighbor, l_baseKey + m_csr.m_weights[l_e] ) ) {
+          l_cost    = l_base + m_csr.m_weights[l_e];
+          io_state.visit( l_neighbor, l_cost, l_next, l_e );
+          io_toExplore.push( l_neighbor, l_cost );
+          ++io_state.m_stats.m_pushes;
+        }
+      }
+    } else
+      ++io_state.m_stats.m_stalePops;
+  }
+
+  return false;
+}
 
-  Actor *l_start  = m_theGraph[i_from];   //! Initial node
-  Actor *l_end    = m_theGraph[i_to];     //! End node
+/** Input params: Index in the graph to traverse from and to, traversal state
+ *  Return param: Boolean stating success of traversal
+ *  Description : A* Traversal
+ *
+ *  Same as DjikstraTraverse, but actors are settled in order of distance plus
+ *  the landmark lower bound on the rest of the way. The bound never drops by
+ *  more than an edge's weight along the edge, so every actor is still settled
+ *  at its least distance, while actors leading away from the target are left
+ *  in the queue.
+ */
+bool ActorGraph::AStarTraverse( const int            &i_from,
+                                const int            &i_to,
+                                      TraversalState &io_state ) const {
+  HeapQueue l_toExplore;                  //! Priority queue (keyed by distance + bound)
+
+  int l_next, l_neighbor;                 //! Actor indices
+  int l_key;                              //! Key an entry was pushed with
+  int l_base;                             //! Distance of the actor expanded
+  int l_cost      = 0;                    //! Cost of traversal
+  uint64_t l_baseKey;                     //! Key of l_base in the state
 
   //! Initial node conditioning
-  l_start->m_dist   = 0;
-  l_toExplore.push( l_start );
-  l_visited.push_back( l_start );
+  io_state.visit( i_from, 0, -1 );
+  l_toExplore.push( i_from, m_landmarks.bound( i_from, i_to ) );
 
   //! Traverse till priority queue isn't empty
   while( !l_toExplore.empty() ) {
     //! Get top element of priority queue
-    l_next = l_toExplore.top();
-    l_toExplore.pop();
+    l_toExplore.pop( l_next, l_key );
+    ++io_state.m_stats.m_popped;
 
-    //! Break if traverse was successful
-    if( l_next == l_end ) {
-      l_found = true;
-      break;
+    //! Return if traverse was successful
+    if( l_next == i_to )
+      return true;
+
+    //! A* algorithm
+    if( !io_state.isDone( l_next ) ) {
+      io_state.markDone( l_next );
+      io_state.m_stats.m_scanned += m_csr.m_offsets[l_next + 1] - m_csr.m_offsets[l_next];
+
+      l_base    = io_state.dist( l_next );
+      l_baseKey = io_state.key( l_base );
+
+      for( int l_e = m_csr.m_offsets[l_next]; l_e < m_csr.m_offsets[l_next + 1]; ++l_e ) {
+        l_neighbor  = m_csr.m_neighbors[l_e];
+
+        if( io_state.improves( l_neighbor, l_baseKey + m_csr.m_weights[l_e] ) ) {
+          l_cost    = l_base + m_csr.m_weights[l_e];
+          io_state.visit( l_neighbor, l_cost, l_next, l_e );
+          l_toExplore.push( l_neighbor, l_cost + m_landmarks.bound( l_neighbor, i_to ) );
+          ++io_state.m_stats.m_pushes;
+        }
+      }
+    } else
+      ++io_state.m_stats.m_stalePops;
+  }
+
+  return false;
+}
+
+/** Input params: Actor index
+ *  Return param: Degree of the actor
+ *  Description : Counts an actor's co-stars
+ *
+ *  The actor-movie graph has no co-star rows, so there the actor's movies
+ *  are counted instead.
+ */
+int ActorGraph::degree( const int &i_actor ) const {
+  if( m_bipartite )
+    return m_bip.m_movieOffsets[i_actor + 1] - m_bip.m_movieOffsets[i_actor];
+
+  return m_csr.degree( i_actor );
+}
+
+/** Input params: Number of actors, actors (passed by reference)
+ *  Return param: None
+ *  Description : Picks the actors with the highest degree
+ */
+void ActorGraph::topActors( const int                &i_count,
+                                  std::vector< int > &o_actors ) const {
+  int l_numActors = m_actorNames.size();
+  int l_count     = std::max( std::min( i_count, l_numActors ), 0 );
+
+  o_actors.resize( l_numActors );
+  for( int l_index = 0; l_index < l_numActors; ++l_index )
+    o_actors[l_index] = l_index;
+
+  std::partial_sort( o_actors.begin(), o_actors.begin() + l_count, o_actors.end(),
+                     [&]( const int &i_lhs, const int &i_rhs ) {
+                       return degree( i_lhs ) > degree( i_rhs ) ||
+                              (degree( i_lhs ) == degree( i_rhs ) && i_lhs < i_rhs);
+                     } );
+
+  o_actors.resize( l_count );
+}
+
+/** Input params: Number of landmarks
+ *  Return param: Boolean stating whether a new table was computed
+ *  Description : Computes the landmark distances
+ *
+ *  Picks the actors with the most co-stars as landmarks and runs a complete
+ *  Djikstra's traversal from each to record its distance to every actor. A
+ *  table already mapped from a snapshot with as many landmarks is kept.
+ */
+bool ActorGraph::buildLandmarks( const int &i_count ) {
+  int l_numActors = m_csr.numNodes();
+  int l_count     = std::min( i_count, l_numActors );
+
+  if( m_landmarks.numLandmarks() == l_count && !m_landmarks.empty() )
+    return false;
+
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
+
+  //! Actors with the most co-stars first
+  std::vector< int > l_order;
+  topActors( l_count, l_order );
+
+  std::vector< int > l_dist( (size_t) l_numActors * l_count );
+  TraversalState     l_state;
+  HeapQueue          l_heap;
+
+  l_state.init( l_numActors, m_movieTable.size() );
+  l_state.m_bucketQueue.init( std::max( m_maxWeight, 0 ) );
+
+  m_landmarks = LandmarkTable();
+
+  for( int l_l = 0; l_l < l_count; ++l_l ) {
+    //! Traverse with no targets, i.e. settle every reachable actor
+    if( m_minWeight < 0 )
+      DjikstraTraverse( l_order[l_l], l_state, l_heap );
+    else
+      DjikstraTraverse( l_order[l_l], l_state, l_state.m_bucketQueue );
+
+    for( int l_index = 0; l_index < l_numActors; ++l_index )
+      l_dist[(size_t) l_index * l_count + l_l] = l_state.dist( l_index );
+
+    m_landmarks.m_landmarks.push_back( l_order[l_l] );
+    l_state.m_bucketQueue.clear();
+    l_state.reset();
+  }
+
+  m_landmarks.m_dist.append( l_dist.data(), l_dist.size() );
+
+  double l_secs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - l_start ).count();
+  std::cout << "Landmarks: " << l_count << " actors, " << m_landmarks.bytes() / (1024.0 * 1024.0)
+            << " MB, built in " << l_secs << "s\n";
+
+  return true;
+}
+
+/** Input params: Number of hubs, file listing the hubs (or NULL), thread count
+ *  Return param: Boolean
+ *  Description : Computes the shortest-path trees of the hubs
+ *
+ *  Hubs are the actors named in the list (one per line) or else the i_count
+ *  actors with the highest degree. A complete traversal of the current mode
+ *  from each hub, on a pool of threads, records every actor's distance,
+ *  previous actor and movie, so a pair with a hub at either end is answered
+ *  by walking the arrays instead of searching.
+ */
+bool ActorGraph::buildHubs( const int  &i_count,
+                            const char *i_list,
+                            const int  &i_threads ) {
+  int l_numActors = m_actorNames.size();
+  std::vector< int > l_hubs;
+  std::string l_s;
+
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
+
+  if( i_list != NULL ) {
+    std::ifstream l_in( i_list );
+    if( !l_in ) {
+      std::cerr << "Failed to read " << i_list << "!\n";
+      return false;
     }
 
-    //! Djikstra's algorithm
-    if( l_next->m_done == false ) {
-      l_next->m_done  = true;
+    while( std::getline( l_in, l_s ) ) {
+      if( l_s.empty() )
+        continue;
+
+      int l_id = findActor( l_s );
+      if( l_id == -1 )
+        std::cout << "Failure to locate node '" << l_s << "'\n";
+      else if( std::find( l_hubs.begin(), l_hubs.end(), l_id ) == l_hubs.end() )
+        l_hubs.push_back( l_id );
+    }
+  } else
+    topActors( i_count, l_hubs );
+
+  m_hubs             = HubTrees();
+  m_hubs.m_hubs      = l_hubs;
+  m_hubs.m_numActors = l_numActors;
+  m_hubs.m_hubOf.assign( l_numActors, -1 );
+  for( size_t l_h = 0; l_h < l_hubs.size(); ++l_h )
+    m_hubs.m_hubOf[l_hubs[l_h]] = (int) l_h;
+
+  m_hubs.m_dist.assign( l_hubs.size() * l_numActors, std::numeric_limits< int >::max() );
+  m_hubs.m_prev.assign( l_hubs.size() * l_numActors, -1 );
+  m_hubs.m_movie.assign( l_hubs.size() * l_numActors, -1 );
+
+  int l_threads = i_threads;
+  if( l_threads <= 0 )
+    l_threads = std::max( (int) std::thread::hardware_concurrency(), 1 );
+  l_threads = std::min( l_threads, std::max( m_hubs.numHubs(), 1 ) );
+
+  std::atomic< int >         l_nextHub( 0 );  //! Next hub to be picked up
+  std::vector< std::thread > l_pool;          //! Worker threads
+
+  //! Each thread fills the trees of the hubs it picks up
+  auto l_worker = [&]() {
+    TraversalState l_state;
+
+    l_state.init( l_numActors, m_movieTable.size() );
+    l_state.m_bucketQueue.init( std::max( m_maxWeight, 0 ) );
+
+    for( int l_h = l_nextHub++; l_h < m_hubs.numHubs(); l_h = l_nextHub++ ) {
+      size_t l_base = (size_t) l_h * l_numActors;
+
+      //! No targets, i.e. settle every reachable actor
+      traverseAll( m_hubs.m_hubs[l_h], l_state );
+
+      for( int l_index = 0; l_index < l_numActors; ++l_index ) {
+        if( l_state.dist( l_index ) == std::numeric_limits< int >::max() )
+          continue;
 
-      for( m_eit = l_next->m_adj.begin(); m_eit != l_next->m_adj.end(); ++m_eit ) {
-        l_neighbor  = m_theGraph[m_eit->first];
-        l_cost      = (l_next->m_dist) + (m_eit->second->m_weight);
+        m_hubs.m_dist[l_base + l_index]  = l_state.dist( l_index );
+        m_hubs.m_prev[l_base + l_index]  = l_state.prev( l_index );
+        m_hubs.m_movie[l_base + l_index] = movieOf( l_state.via( l_index ) );
+      }
+
+      l_state.reset();
+    }
+  };
+
+  for( int l_t = 1; l_t < l_threads; ++l_t )
+    l_pool.push_back( std::thread( l_worker ) );
+
+  l_worker();   //! The calling thread works too
+
+  for( std::thread &l_thread : l_pool )
+    l_thread.join();
+
+  double l_secs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - l_start ).count();
+  std::cout << "Hubs: " << m_hubs.numHubs() << " actors, " << m_hubs.bytes() / (1024.0 * 1024.0)
+            << " MB, built in " << l_secs << "s\n";
+
+  return true;
+}
+
+/** Input params: Output filename, thread count
+ *  Return param: Boolean
+ *  Description : Writes the hub distance table
+ *
+ *  One line per actor with its distance from each hub (the Bacon number,
+ *  with Kevin Bacon as the hub), -1 if it isn't connected to the hub. Actors
+ *  and hubs are written as names, or as ids if the output is. Blocks of
+ *  lines are formatted on a pool of threads and written in actor order.
+ */
+bool ActorGraph::writeHubTable( const char *i_outfile,
+                                const int  &i_threads ) const {
+  int l_numActors = m_actorNames.size();
+  OutputWriter l_out;
+  std::string  l_line;
+
+  if( !l_out.open( i_outfile ) ) {
+    std::cerr << "Failed to open " << i_outfile << "!\n";
+    return false;
+  }
+
+  //! First line: the hubs
+  l_line = "Actor";
+  for( int l_hub : m_hubs.m_hubs ) {
+    l_line.push_back( '\t' );
+    l_line += m_idOutput ? std::to_string( l_hub ) : m_actorNames.name( l_hub );
+  }
+  l_out.writeLine( l_line );
+
+  int l_threads = i_threads;
+  if( l_threads <= 0 )
+    l_threads = std::max( (int) std::thread::hardware_concurrency(), 1 );
+
+  std::vector< std::string > l_lines;          //! Lines of the chunk
+  std::vector< std::thread > l_pool;           //! Worker threads
+  std::atomic< size_t >      l_nextBlock;      //! Next block to be picked up
+  size_t                     l_begin, l_size;  //! Chunk of actors
+
+  //! Each thread formats the lines of the blocks it picks up
+  auto l_worker = [&]() {
+    for( size_t l_b = l_nextBlock++; l_b * g_tableBlock < l_size; l_b = l_nextBlock++ ) {
+      for( size_t l_k = l_b * g_tableBlock; l_k < std::min( (l_b + 1) * g_tableBlock, l_size ); ++l_k ) {
+        int l_index = (int) (l_begin + l_k);
+        std::string &l_str = l_lines[l_k];
+
+        l_str = m_idOutput ? std::to_string( l_index ) : m_actorNames.name( l_index );
+        for( int l_h = 0; l_h < m_hubs.numHubs(); ++l_h ) {
+          int l_dist = m_hubs.dist( l_h, l_index );
+
+          l_str.push_back( '\t' );
+          l_str += std::to_string( l_dist == std::numeric_limits< int >::max() ? -1 : l_dist );
+        }
+      }
+    }
+  };
+
+  //! Chunk by chunk, so only one chunk's lines are held before being written out
+  for( l_begin = 0; l_begin < (size_t) l_numActors; l_begin += g_queryChunk ) {
+    l_size = std::min( g_queryChunk, l_numActors - l_begin );
+    l_lines.resize( l_size );
+    l_nextBlock = 0;
+
+    l_pool.clear();
+    for( int l_t = 1; l_t < l_threads; ++l_t )
+      l_pool.push_back( std::thread( l_worker ) );
+
+    l_worker();   //! The calling thread works too
+
+    for( std::thread &l_thread : l_pool )
+      l_thread.join();
+
+    for( size_t l_k = 0; l_k < l_size; ++l_k )
+      l_out.writeLine( l_lines[l_k] );
+  }
+
+  if( !l_out.close() ) {
+    std::cerr << "Failed to write " << i_outfile << "!\n";
+    return false;
+  }
 
-        if( l_cost < l_neighbor->m_dist ) {
-          l_neighbor->m_dist  = l_cost;
-          l_neighbor->m_prev  = l_next->m_index;
+  std::cout << "Hub table: " << l_numActors << " actors, " << m_hubs.numHubs() << " hubs\n";
+
+  return true;
+}
+
+/** Input params: Index in the graph to traverse from, traversal state
+ *  Return param: Boolean stating whether all targets were reached
+ *  Description : BFS Traversal over the actor-movie graph
+ *
+ *  Same traversal as BFSTraverse, but a node's neighbors are found through
+ *  its movies and every movie is expanded at most once per query: once its
+ *  cast has been reached, a later visit cannot shorten any of their paths.
+ */
+bool ActorGraph::bipartiteBFSTraverse( const int            &i_from,
+                                             TraversalState &io_state ) const {
+  std::queue< int > l_toExplore;        //! Queue to explore
+  int l_next, l_neighbor;               //! Actor indices
+  int l_movie;                          //! Movie index
+  int l_dist;                           //! Distance of the next level
+  uint64_t l_key;                       //! Its key in the state
+
+  //! Intial node conditioning
+  io_state.visit( i_from, 0, -1 );
+  l_toExplore.push( i_from );
+
+  //! Traverse till queue isn't empty
+  while( !l_toExplore.empty() ) {
+    //! Get front element from queue
+    l_next  = l_toExplore.front();
+    l_toExplore.pop();
+    ++io_state.m_stats.m_popped;
+
+    //! Return once the last target is reached
+    if( io_state.settle( l_next ) )
+      return true;
+
+    l_dist = io_state.dist( l_next ) + 1;
+    l_key  = io_state.key( l_dist );
+
+    //! Breadth-first search algorithm (actor -> movie -> cast)
+    for( int l_m = m_bip.m_movieOffsets[l_next]; l_m < m_bip.m_movieOffsets[l_next + 1]; ++l_m ) {
+      l_movie = m_bip.m_movieIds[l_m];
+      if( !io_state.expand( l_movie ) )
+        continue;
+
+      io_state.m_stats.m_scanned += m_bip.m_castOffsets[l_movie + 1] - m_bip.m_castOffsets[l_movie];
+      for( int l_c = m_bip.m_castOffsets[l_movie]; l_c < m_bip.m_castOffsets[l_movie + 1]; ++l_c ) {
+        l_neighbor  = m_bip.m_castIds[l_c];
+
+        if( io_state.improves( l_neighbor, l_key ) ) {
+          io_state.visit( l_neighbor, l_dist, l_next, l_movie );
           l_toExplore.push( l_neighbor );
-          l_visited.push_back( l_neighbor );
+          ++io_state.m_stats.m_pushes;
         }
       }
     }
   }
 
-  //! For successful traversals, store path information (movies and actors)
-  if( l_found ) {
-    std::vector< std::string > l_output;
-    int l_prevInd;
-    std::string l_actor, l_movie, l_result;
+  return false;
+}
+
+/** Input params: Index in the graph to traverse from, traversal state and
+ *                priority queue
+ *  Return param: Boolean stating whether all targets were settled
+ *  Description : Djikstra's Traversal over the actor-movie graph
+ *
+ *  Same traversal as DjikstraTraverse. The weight of an actor-actor hop only
+ *  depends on the movie, so the first settled actor of a movie reaches its
+ *  whole cast at the least cost and the movie is never expanded again.
+ */
+template< class Queue >
+bool ActorGraph::bipartiteDjikstraTraverse( const int            &i_from,
+                                                  TraversalState &io_state,
+                                                  Queue          &io_toExplore ) const {
+  int l_next, l_neighbor;                 //! Actor indices
+  int l_dist;                             //! Distance an entry was pushed with
+  int l_movie;                            //! Movie index
+  int l_cost      = 0;                    //! Cost of traversal
+  uint64_t l_costKey;                     //! Key of l_cost in the state
+
+  //! Initial node conditioning
+  io_state.visit( i_from, 0, -1 );
+  io_toExplore.push( i_from, 0 );
+
+  //! Traverse till priority queue isn't empty
+  while( !io_toExplore.empty() ) {
+    //! Get top element of priority queue
+    io_toExplore.pop( l_next, l_dist );
+    ++io_state.m_stats.m_popped;
+
+    //! Djikstra's algorithm (actor -> movie -> cast)
+    if( !io_state.isDone( l_next ) ) {
+      io_state.markDone( l_next );
 
-    Actor *l_curr = m_theGraph[l_end->m_prev];
+      //! Return once the last target is settled
+      if( io_state.settle( l_next ) )
+        return true;
 
-    m_aai     = m_actorAtIndex.find( l_end->m_index );
-    l_actor   = "(" + m_aai->second + ")";
-    l_prevInd = l_end->m_index;
-    l_output.push_back( l_actor );
+      for( int l_m = m_bip.m_movieOffsets[l_next]; l_m < m_bip.m_movieOffsets[l_next + 1]; ++l_m ) {
+        l_movie = m_bip.m_movieIds[l_m];
+        if( !io_state.expand( l_movie ) )
+          continue;
 
-    while( l_curr != l_start ) {
-      l_movie   = "--[" + findMovieEdge( l_curr, l_prevInd ) + "]-->";
-      l_output.push_back( l_movie );
+        l_cost    = io_state.dist( l_next ) + m_bip.m_movieWeights[l_movie];
+        l_costKey = io_state.key( l_cost );
+        io_state.m_stats.m_scanned += m_bip.m_castOffsets[l_movie + 1] - m_bip.m_castOffsets[l_movie];
 
-      m_aai     = m_actorAtIndex.find( l_curr->m_index );
-      l_actor   = "(" + m_aai->second + ")";
-      l_output.push_back( l_actor );
+        for( int l_c = m_bip.m_castOffsets[l_movie]; l_c < m_bip.m_castOffsets[l_movie + 1]; ++l_c ) {
+          l_neighbor  = m_bip.m_castIds[l_c];
 
-      l_prevInd = l_curr->m_index;
-      l_curr    = m_theGraph[l_curr->m_prev];
+          if( io_state.improves( l_neighbor, l_costKey ) ) {
+            io_state.visit( l_neighbor, l_cost, l_next, l_movie );
+            io_toExplore.push( l_neighbor, l_cost );
+            ++io_state.m_stats.m_pushes;
+          }
+        }
+      }
+    } else
+      ++io_state.m_stats.m_stalePops;
+  }
+
+  return false;
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Whether the search runs per pair
+ *
+ *  A*, bidirectional and direction-optimizing BFS head for one target; the
+ *  other traversals settle actors in distance order from the source and can
+ *  serve any number of targets in one go.
+ */
+bool ActorGraph::isPairSearch() const {
+  return !m_bipartite && (m_search == "astar" || m_search == "bidir" || m_search == "dobfs");
+}
+
+/** Input params: Index in the graph to traverse from, traversal state
+ *  Return param: None
+ *  Description : Single-source traversal of the current mode
+ *
+ *  BFS or Djikstra's traversal over the co-star or the actor-movie graph,
+ *  until the targets added to the state are settled (every reachable actor
+ *  if there are none). The state is left for the caller to read and reset.
+ */
+void ActorGraph::traverseAll( const int            &i_from,
+                                    TraversalState &io_state ) const {
+  if( m_useWeightedEdges != "u" && (m_search == "dijkstra" || m_minWeight < 0) ) {
+    //! Binary heap when asked for (or when Dial's buckets can't hold the weights)
+    HeapQueue l_heap;
+
+    if( m_bipartite )
+      bipartiteDjikstraTraverse( i_from, io_state, l_heap );
+    else
+      DjikstraTraverse( i_from, io_state, l_heap );
+  } else if( m_useWeightedEdges != "u" ) {
+    //! Dial's buckets otherwise
+    if( m_bipartite )
+      bipartiteDjikstraTraverse( i_from, io_state, io_state.m_bucketQueue );
+    else
+      DjikstraTraverse( i_from, io_state, io_state.m_bucketQueue );
+
+    io_state.m_bucketQueue.clear();
+  } else if( m_bipartite )
+    bipartiteBFSTraverse( i_from, io_state );
+  else
+    BFSTraverse( i_from, io_state );
+}
+
+/** Input params: Index in the graph to traverse from, targets, traversal
+ *                state and paths found (passed by reference)
+ *  Return param: None
+ *  Description : Finds the paths from one actor
+ *
+ *  Performs proper traversal corresponding to weighted/unweighted edges and
+ *  the graph mode, once for all targets unless the search runs per pair,
+ *  formats the paths (empty if there is none) and resets the state for the
+ *  next source. The paths of o_paths are cleared and reused.
+ */
+void ActorGraph::findPaths( const int                                &i_from,
+                            const std::vector< int >                 &i_targets,
+                                  TraversalState                     &io_state,
+                                  std::vector< std::vector< int > >  &o_paths ) const {
+  bool l_found;
+
+  o_paths.resize( i_targets.size() );
+  for( std::vector< int > &l_path : o_paths )
+    l_path.clear();
+
+  //! Searches heading for one target
+  if( isPairSearch() ) {
+    for( size_t l_t = 0; l_t < i_targets.size(); ++l_t ) {
+      if( m_search == "astar" )
+        l_found = AStarTraverse( i_from, i_targets[l_t], io_state );
+      else if( m_search == "bidir" )
+        l_found = bidirectionalBFSTraverse( i_from, i_targets[l_t], io_state );
+      else
+        l_found = directionBFSTraverse( i_from, i_targets[l_t], io_state );
+
+      //! For successful traversals, trace path information (movies and actors)
+      if( l_found )
+        tracePath( i_from, i_targets[l_t], io_state, o_paths[l_t] );
+
+      io_state.reset();
     }
 
-    l_movie = "--[" + findMovieEdge( l_start, l_prevInd ) + "]-->";
-    l_output.push_back( l_movie );
+    return;
+  }
+
+  //! Single-source searches stop once every target is settled
+  for( int l_target : i_targets )
+    io_state.addTarget( l_target );
+
+  traverseAll( i_from, io_state );
+
+  //! Trace path information of the targets reached
+  for( size_t l_t = 0; l_t < i_targets.size(); ++l_t )
+    if( io_state.dist( i_targets[l_t] ) != std::numeric_limits< int >::max() )
+      tracePath( i_from, i_targets[l_t], io_state, o_paths[l_t] );
+
+  io_state.reset();
+}
+
+/** Input params: Actor pairs, paths found (passed by reference), thread count,
+ *                counters of the search of each pair and of all searches (or
+ *                NULL)
+ *  Return param: Number of actors visited by all queries
+ *  Description : Runs a batch of queries
+ *
+ *  Plans the batch first: pairs are sorted by source and target, so repeated
+ *  pairs are searched once and all pairs of a source share one single-source
+ *  search (or run back to back, for searches heading for one target). The
+ *  graph is only read while searching, so the sources are handed out to a
+ *  pool of threads, each with its own traversal state. Paths are stored at
+ *  the position of their pair, keeping the output in input order.
+ */
+long long ActorGraph::runQueries( const std::vector< std::pair< int, int > > &i_queries,
+                                        std::vector< std::vector< int > >    &o_paths,
+                                  const int                                  &i_threads,
+                                        std::vector< QueryStats >            *o_stats,
+                                        QueryStats                           *o_total ) const {
+  std::atomic< size_t >      l_nextGroup( 0 );  //! Next group to be picked up
+  std::atomic< long long >   l_numVisited( 0 ); //! Actors visited by all threads
+  std::mutex                 l_totalLock;       //! Guards *o_total
+  std::vector< std::thread > l_pool;            //! Worker threads
+  std::vector< size_t >      l_order;           //! Pairs sorted by source and target
+  std::vector< size_t >      l_groups;          //! Start of each group in l_order
+  size_t                     l_numDistinct = 0; //! Distinct pairs
+
+  o_paths.resize( i_queries.size() );
+  if( o_stats != NULL )
+    o_stats->resize( i_queries.size() );
+
+  for( size_t l_q = 0; l_q < i_queries.size(); ++l_q )
+    l_order.push_back( l_q );
+
+  std::stable_sort( l_order.begin(), l_order.end(),
+                    [&]( const size_t &i_lhs, const size_t &i_rhs ) {
+                      return i_queries[i_lhs] < i_queries[i_rhs];
+                    } );
+
+  //! A group per source (per distinct pair if the search runs per pair)
+  for( size_t l_k = 0; l_k < l_order.size(); ++l_k ) {
+    const std::pair< int, int > &l_pair = i_queries[l_order[l_k]];
+
+    if( l_k > 0 && l_pair == i_queries[l_order[l_k - 1]] )
+      continue;
+
+    ++l_numDistinct;
+    if( l_k == 0 || isPairSearch() || l_pair.first != i_queries[l_order[l_k - 1]].first )
+      l_groups.push_back( l_k );
+  }
+
+  l_groups.push_back( l_order.size() );
+
+  std::cout << "Planned " << i_queries.size() << " pairs (" << l_numDistinct << " distinct) as "
+            << l_groups.size() - 1 << " searches\n";
+
+  int l_numThreads = (int) std::min( (size_t) std::max( i_threads, 1 ), l_groups.size() );
+
+  auto l_worker = [&]() {
+    TraversalState                    l_state;
+    std::vector< int >                l_targets;  //! Distinct targets of the group
+    std::vector< std::vector< int > > l_paths;    //! Path to each of them
+    QueryStats                        l_searches; //! Counters of the thread's searches
+
+    l_state.init( m_actorNames.size(), m_movieTable.size() );
+    l_state.m_bucketQueue.init( std::max( m_maxWeight, 0 ) );
+
+    for( size_t l_g = l_nextGroup++; l_g + 1 < l_groups.size(); l_g = l_nextGroup++ ) {
+      l_targets.clear();
+      for( size_t l_k = l_groups[l_g]; l_k < l_groups[l_g + 1]; ++l_k )
+        if( l_targets.empty() || l_targets.back() != i_queries[l_order[l_k]].second )
+          l_targets.push_back( i_queries[l_order[l_k]].second );
+
+      QueryStats l_before = l_state.m_stats;
+      std::chrono::high_resolution_clock::time_point l_start;
+      l_start = std::chrono::high_resolution_clock::now();
+
+      findPaths( i_queries[l_order[l_groups[l_g]]].first, l_targets, l_state, l_paths );
+
+      //! Every pair of the group gets the counters of the search
+      QueryStats l_search = l_state.m_stats.since( l_before );
+      l_search.m_micros   = std::chrono::duration< double, std::micro >( std::chrono::high_resolution_clock::now() - l_start ).count();
+      l_search.m_targets  = (long long) l_targets.size();
+      l_searches         += l_search;
+
+      //! Hand the paths back to every pair of the group (in target order)
+      size_t l_t = 0;
+      for( size_t l_k = l_groups[l_g]; l_k < l_groups[l_g + 1]; ++l_k ) {
+        if( i_queries[l_order[l_k]].second != l_targets[l_t] )
+          ++l_t;
+
+        o_paths[l_order[l_k]] = l_paths[l_t];
+        if( o_stats != NULL )
+          (*o_stats)[l_order[l_k]] = l_search;
+      }
+    }
+
+    l_numVisited += l_state.m_numVisited;
+
+    if( o_total != NULL ) {
+      std::lock_guard< std::mutex > l_guard( l_totalLock );
+      *o_total += l_searches;
+    }
+  };
+
+  for( int l_t = 1; l_t < l_numThreads; ++l_t )
+    l_pool.push_back( std::thread( l_worker ) );
+
+  l_worker();   //! The calling thread works too
+
+  for( std::thread &l_thread : l_pool )
+    l_thread.join();
+
+  return l_numVisited;
+}
+
+/** Input params: Actor name
+ *  Return param: Global actor index
+ *  Description : Looks up an actor
+ *
+ *  Assigns the actor the next global index when first seen, so indices follow
+ *  the order of the movie cast file.
+ */
+int ActorGraph::internActor( const std::string &i_actor ) {
+  m_ioa = m_indexOfActor.find( i_actor );
+  if( m_ioa != m_indexOfActor.end() )
+    return m_ioa->second;
+
+  //! Actor doesnt exist as key in map, insert it
+  int l_actor             = m_actorNames.size();
+  m_indexOfActor[i_actor] = l_actor;
+  m_actorNames.append( i_actor.data(), (int) i_actor.size() );
 
-    m_aai   = m_actorAtIndex.find( l_start->m_index );
-    l_actor = "(" + m_aai->second + ")";
-    l_output.push_back( l_actor );
+  return l_actor;
+}
+
+/** Input params: Movie (of form movie#@year) and its year
+ *  Return param: Movie-id
+ *  Description : Interns a movie
+ */
+int ActorGraph::internMovie( const std::string &i_movie,
+                             const int         &i_year ) {
+  return m_movieTable.intern( i_movie, i_year );
+}
+
+/** Input params: Global actor index and movie-id
+ *  Return param: None
+ *  Description : Records one line of the movie cast file
+ */
+void ActorGraph::addCredit( const int &i_actor,
+                            const int &i_movie ) {
+  m_loadCredits.push_back( std::make_pair( i_actor, i_movie ) );
+}
 
-    std::reverse( l_output.begin(), l_output.end() );
+/** Input params: None
+ *  Return param: None
+ *  Description : Finishes a load from a cast file
+ *
+ *  Counting-sorts the credits into the filmography of each actor and the cast
+ *  of each movie (both keeping file order), sorts the actor names for lookup
+ *  and frees everything that was only needed while loading.
+ */
+void ActorGraph::finishLoad() {
+  int l_numActors = m_actorNames.size();
+  int l_numMovies = m_movieTable.size();
+  std::vector< int > l_filmCount( l_numActors + 1, 0 ), l_castCount( l_numMovies + 1, 0 );
+  std::vector< int > l_filmIds( m_loadCredits.size() ), l_castIds( m_loadCredits.size() );
+  std::vector< std::pair< int, int > >::iterator l_it;
+
+  //! Count credits per actor and per movie, then turn counts into offsets
+  for( l_it = m_loadCredits.begin(); l_it != m_loadCredits.end(); ++l_it ) {
+    l_filmCount[l_it->first + 1]++;
+    l_castCount[l_it->second + 1]++;
+  }
+
+  for( int l_i = 0; l_i < l_numActors; ++l_i )
+    l_filmCount[l_i + 1] += l_filmCount[l_i];
 
-    for( std::string l_s : l_output )
-      l_result += l_s;
+  for( int l_i = 0; l_i < l_numMovies; ++l_i )
+    l_castCount[l_i + 1] += l_castCount[l_i];
 
-    m_outLines.push_back( l_result ); //! Store output line to be written out later
+  m_bip.m_movieOffsets.clear();
+  m_bip.m_movieOffsets.append( &l_filmCount[0], l_filmCount.size() );
+  m_bip.m_castOffsets.clear();
+  m_bip.m_castOffsets.append( &l_castCount[0], l_castCount.size() );
+
+  //! Place every credit (counts now serve as insertion cursors)
+  for( l_it = m_loadCredits.begin(); l_it != m_loadCredits.end(); ++l_it ) {
+    l_filmIds[l_filmCount[l_it->first]++]  = l_it->second;
+    l_castIds[l_castCount[l_it->second]++] = l_it->first;
   }
 
-  //! Reset distances, done & prev info for all visited nodes during traversal
-  for( m_ait = l_visited.begin(); m_ait != l_visited.end(); ++m_ait ) {
-    (*m_ait)->m_dist = std::numeric_limits< int >::max();
-    (*m_ait)->m_prev = -1;
-    (*m_ait)->m_done = false;
+  m_bip.m_movieIds.clear();
+  m_bip.m_castIds.clear();
+  if( !m_loadCredits.empty() ) {
+    m_bip.m_movieIds.append( &l_filmIds[0], l_filmIds.size() );
+    m_bip.m_castIds.append( &l_castIds[0], l_castIds.size() );
   }
+
+  //! Loading-only state
+  std::vector< std::pair< int, int > >().swap( m_loadCredits );
+  std::unordered_map< std::string, int >().swap( m_indexOfActor );
+  m_movieTable.finishInterning();
+
+  m_actorNames.sortIndex();
+}
+
+/** Input params: Actor name
+ *  Return param: Global actor index (-1 if not present)
+ *  Description : Looks up an actor by name
+ */
+int ActorGraph::findActor( const std::string &i_actor ) const {
+  return m_actorNames.find( i_actor );
 }
 
 /** Input params: Input filename
@@ -406,7 +1413,13 @@ void ActorGraph::DjikstraTraverse( const int &i_from,
  *  construct the graph and use in the graph traversal.
  */
 bool ActorGraph::loadFromFile( const char *i_infile ) {
-  std::string l_movie, l_s;
+  std::string l_s;
+  double l_bytes;
+  int    l_year;
+  size_t l_line = 1;    //! Line number (the header is line 1)
+
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
 
   // Initialize the file stream
   std::ifstream l_in( i_infile );
@@ -423,6 +1436,7 @@ bool ActorGraph::loadFromFile( const char *i_infile ) {
     if( !std::getline( l_in, l_s ) )
       break;
 
+    l_line++;
     std::istringstream l_ss( l_s );
     std::vector< std::string > l_record;
 
@@ -441,28 +1455,15 @@ bool ActorGraph::loadFromFile( const char *i_infile ) {
       continue;
     }
 
-    std::string l_actorName( l_record[0] );
-    l_movie = l_record[1] + "#@" + l_record[2];
-
-    m_aim = m_actorsInMovie.find( l_movie );
-    //! If movie doesnt exist as key in map, insert it
-    if( m_aim == m_actorsInMovie.end() ) {
-      std::vector< std::string > l_actorList{ l_actorName };
-      m_actorsInMovie[l_movie] = l_actorList;
+    //! Skip lines whose year isn't a number, like the mapped loader
+    if( !CastLoader::parseYear( l_record[2].data(), l_record[2].data() + l_record[2].size(), l_year ) ) {
+      std::cerr << "Skipping line " << l_line << ": year '" << l_record[2] << "' is not a number\n";
+      continue;
     }
-    //! Otherwise add actor to list of actors in the movie
-    else
-      (m_aim->second).push_back( l_actorName );
 
-    m_moa = m_moviesOfActor.find( l_actorName );
-    //! If actor doesnt exist as key in map, insert it
-    if( m_moa == m_moviesOfActor.end() ) {
-      std::vector< std::string > l_movieList{ l_movie };
-      m_moviesOfActor[l_actorName] = l_movieList;
-    }
-    //! Otherwise add movie to list of movies done by the actor
-    else
-      (m_moa->second).push_back( l_movie );
+    //! Intern the actor and movie and record the credit
+    addCredit( internActor( l_record[0] ),
+               internMovie( l_record[1] + "#@" + l_record[2], l_year ) );
   }
 
   if( !l_in.eof() ) {
@@ -470,32 +1471,311 @@ bool ActorGraph::loadFromFile( const char *i_infile ) {
     return false;
   }
 
+  //! Size of the file for the throughput report
+  l_in.clear();
+  l_in.seekg( 0, std::ios::end );
+  l_bytes = (double) l_in.tellg();
+
   l_in.close();
 
-  //! Assign global index to each actor, create 2 hashmaps (id-name & vice-versa)
-  int l_index = 0;
-  for( m_moa = m_moviesOfActor.begin(); m_moa != m_moviesOfActor.end(); ++m_moa ) {
-    m_actorAtIndex[l_index]       = m_moa->first;
-    m_indexOfActor[m_moa->first]  = l_index++;
-  }
+  finishLoad();
 
-  std::cout << "done\n";
+  reportLoad( l_bytes, l_start );
 
   return true;
 }
 
 /** Input params: Input filename
+ *  Return param: Boolean
+ *  Description : Loads from input movie cast file (memory-mapped)
+ *
+ *  Same result as loadFromFile, but the file is memory-mapped and split in
+ *  place by CastLoader. Names are looked up through references into the
+ *  mapping, so a string is only built the first time an actor or a movie is
+ *  seen.
+ */
+bool ActorGraph::loadFromMappedFile( const char *i_infile ) {
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
+
+  CastLoader l_loader;
+
+  std::cout << "Reading " << i_infile << ".. ";
+
+  if( !l_loader.map( i_infile ) ) {
+    std::cerr << "Failed to read " << i_infile << "!\n";
+    return false;
+  }
+
+  l_loader.scan();
+
+  double l_scanSecs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - l_start ).count();
+
+  //! Index of actor and movie for each name already seen in the mapping
+  std::unordered_map< StrRef, int, StrRefHash > l_actorIds, l_movieIds;
+  std::unordered_map< StrRef, int, StrRefHash >::iterator l_it;
+  std::vector< CastRecord >::const_iterator l_rit;
+  int l_actor, l_movie;
+
+  //! Credits bound the number of distinct names, so these maps never rehash
+  l_actorIds.reserve( l_loader.records().size() );
+  l_movieIds.reserve( l_loader.records().size() );
+
+  for( l_rit = l_loader.records().begin(); l_rit != l_loader.records().end(); ++l_rit ) {
+    l_it = l_actorIds.find( l_rit->m_actor );
+    if( l_it == l_actorIds.end() ) {
+      l_actor = internActor( l_rit->m_actor.str() );
+      l_actorIds[l_rit->m_actor] = l_actor;
+    } else
+      l_actor = l_it->second;
+
+    l_it = l_movieIds.find( l_rit->m_movieKey );
+    if( l_it == l_movieIds.end() ) {
+      std::string l_name( l_rit->m_movieKey.str() );
+      l_name.replace( l_rit->m_title.m_len, 1, "#@" );  //! title<tab>year -> title#@year
+
+      l_movie = internMovie( l_name, l_rit->m_year );
+      l_movieIds[l_rit->m_movieKey] = l_movie;
+    } else
+      l_movie = l_it->second;
+
+    addCredit( l_actor, l_movie );
+  }
+
+  double l_bytes = (double) l_loader.size();
+
+  l_loader.unmap();
+  finishLoad();
+
+  reportLoad( l_bytes, l_start, l_scanSecs );
+
+  return true;
+}
+
+/** Input params: Bytes read, start time of the load and time spent splitting
+ *                the file into records (0 if not measured separately)
+ *  Return param: None
+ *  Description : Prints the load throughput
+ */
+void ActorGraph::reportLoad( const double                                         &i_bytes,
+                             const std::chrono::high_resolution_clock::time_point &i_start,
+                             const double                                         &i_scanSecs ) {
+  double l_secs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - i_start ).count();
+  double l_mb   = i_bytes / (1024.0 * 1024.0);
+
+  std::cout << "done (" << l_mb << " MB in " << l_secs << "s, "
+            << (l_secs > 0 ? l_mb / l_secs : 0) << " MB/s";
+
+  if( i_scanSecs > 0 )
+    std::cout << "; scan " << l_mb / i_scanSecs << " MB/s";
+
+  std::cout << ")\n";
+}
+
+/** Input params: Snapshot filename and the cast file it stands for
+ *  Return param: Boolean (false if the graph must be loaded from the cast file)
+ *  Description : Loads from a snapshot
+ *
+ *  Maps the snapshot and points names, movies, credits and (if it was saved
+ *  for the same weighted/unweighted mode) the co-star adjacency into it,
+ *  without touching any element. A snapshot whose cast file has since changed
+ *  size or modification time is ignored.
+ */
+bool ActorGraph::loadSnapshot( const char *i_snapshot,
+                               const char *i_source ) {
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
+
+  std::string l_error;
+  uint64_t    l_size;
+  int64_t     l_mtime;
+
+  if( !m_snapshot.open( i_snapshot, l_error ) ) {
+    if( l_error != "cannot open" )
+      std::cerr << "Ignoring snapshot " << i_snapshot << ": " << l_error << "\n";
+
+    return false;
+  }
+
+  const SnapshotHeader &l_header = m_snapshot.header();
+  if( sourceStamp( i_source, l_size, l_mtime ) &&
+      (l_size != l_header.m_sourceSize || l_mtime != l_header.m_sourceMtime) ) {
+    std::cout << "Snapshot " << i_snapshot << " is out of date, rebuilding\n";
+    m_snapshot.close();
+    return false;
+  }
+
+  bool l_ok = m_snapshot.view( SNAP_ACTOR_CHARS,   m_actorNames.m_chars )         &&
+              m_snapshot.view( SNAP_ACTOR_OFFSETS, m_actorNames.m_offsets )       &&
+              m_snapshot.view( SNAP_ACTOR_SORTED,  m_actorNames.m_sorted )        &&
+              m_snapshot.view( SNAP_MOVIE_CHARS,   m_movieTable.m_names.m_chars ) &&
+              m_snapshot.view( SNAP_MOVIE_OFFSETS, m_movieTable.m_names.m_offsets ) &&
+              m_snapshot.view( SNAP_MOVIE_YEARS,   m_movieTable.m_years )         &&
+              m_snapshot.view( SNAP_FILM_OFFSETS,  m_bip.m_movieOffsets )         &&
+              m_snapshot.view( SNAP_FILM_IDS,      m_bip.m_movieIds )             &&
+              m_snapshot.view( SNAP_CAST_OFFSETS,  m_bip.m_castOffsets )          &&
+              m_snapshot.view( SNAP_CAST_IDS,      m_bip.m_castIds );
+
+  //! Co-star adjacency built for the same kind of edges (u and w each have their own)
+  char l_edges = m_useWeightedEdges[0];
+  if( l_ok && m_snapshot.has( adjacencySection( SNAP_CSR_OFFSETS, l_edges ) ) )
+    l_ok = m_snapshot.view( adjacencySection( SNAP_CSR_OFFSETS,   l_edges ), m_csr.m_offsets )   &&
+           m_snapshot.view( adjacencySection( SNAP_CSR_NEIGHBORS, l_edges ), m_csr.m_neighbors ) &&
+           m_snapshot.view( adjacencySection( SNAP_CSR_WEIGHTS,   l_edges ), m_csr.m_weights )   &&
+           m_snapshot.view( adjacencySection( SNAP_CSR_MOVIES,    l_edges ), m_csr.m_movies );
+
+  //! Landmarks were computed over that adjacency
+  if( l_ok && !m_csr.m_offsets.empty() && m_snapshot.has( adjacencySection( SNAP_LANDMARKS, l_edges ) ) )
+    l_ok = m_snapshot.view( adjacencySection( SNAP_LANDMARKS,     l_edges ), m_landmarks.m_landmarks ) &&
+           m_snapshot.view( adjacencySection( SNAP_LANDMARK_DIST, l_edges ), m_landmarks.m_dist );
+
+  //! Connection index only depends on the credits
+  if( l_ok && m_snapshot.has( SNAP_CONNECT_PARENT ) )
+    l_ok = m_snapshot.view( SNAP_CONNECT_PARENT, m_connections.m_parent ) &&
+           m_snapshot.view( SNAP_CONNECT_YEAR,   m_connections.m_year )   &&
+           m_snapshot.view( SNAP_CONNECT_DEPTH,  m_connections.m_depth )  &&
+           m_snapshot.view( SNAP_CONNECT_HEAD,   m_connections.m_head );
+
+  //! Shapes must agree (element values are trusted)
+  int l_numActors = m_actorNames.size();
+  int l_numMovies = m_movieTable.m_names.size();
+
+  l_ok = l_ok &&
+         (int) m_actorNames.m_sorted.size() == l_numActors &&
+         (int) m_movieTable.m_years.size()  == l_numMovies &&
+         (int) m_bip.m_movieOffsets.size()  == l_numActors + 1 &&
+         m_bip.numMovies()                  == l_numMovies &&
+         (size_t) m_bip.m_movieOffsets[l_numActors] == m_bip.m_movieIds.size() &&
+         (size_t) m_bip.m_castOffsets[l_numMovies]  == m_bip.m_castIds.size() &&
+         (m_csr.m_offsets.empty() ||
+          ((int) m_csr.m_offsets.size() == l_numActors + 1 &&
+           (size_t) m_csr.m_offsets[l_numActors] == m_csr.m_neighbors.size())) &&
+         m_landmarks.m_dist.size() == m_landmarks.m_landmarks.size() * l_numActors &&
+         (m_connections.empty() ||
+          (m_connections.numNodes() >= l_numActors && m_connections.numNodes() < 2 * l_numActors &&
+           m_connections.m_year.size()  == m_connections.m_parent.size() &&
+           m_connections.m_depth.size() == m_connections.m_parent.size() &&
+           m_connections.m_head.size()  == m_connections.m_parent.size()));
+
+  if( !l_ok ) {
+    std::cerr << "Ignoring snapshot " << i_snapshot << ": missing or inconsistent sections\n";
+    m_actorNames  = NameTable();
+    m_movieTable  = MovieTable();
+    m_bip         = BipartiteGraph();
+    m_csr         = ActorCSR();
+    m_landmarks   = LandmarkTable();
+    m_connections = ConnectionIndex();
+    m_snapshot.close();
+    return false;
+  }
+
+  double l_secs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - l_start ).count();
+  std::cout << "Mapped snapshot " << i_snapshot << " (" << l_numActors << " actors, "
+            << l_numMovies << " movies, " << m_bip.numCredits() << " credits"
+            << (m_csr.m_offsets.empty() ? "" : ", co-star adjacency")
+            << (m_landmarks.empty() ? "" : ", landmarks")
+            << (m_connections.empty() ? "" : ", connection index") << ") in "
+            << l_secs << "s\n";
+
+  return true;
+}
+
+/** Input params: Snapshot filename and the cast file it stands for
+ *  Return param: Boolean
+ *  Description : Saves a snapshot
+ *
+ *  Writes names, movies and credits, plus the co-star adjacency (and its
+ *  landmarks) and the connection index if they have been built, stamped with the size and modification
+ *  time of the cast file. Optional sections this run has not built (the
+ *  adjacency of the other of u/w, or the connection index) are carried over
+ *  from the mapped snapshot, so no run drops another's work.
+ */
+bool ActorGraph::saveSnapshot( const char *i_snapshot,
+                               const char *i_source ) {
+  SnapshotWriter l_writer;
+
+  sourceStamp( i_source, l_writer.m_header.m_sourceSize, l_writer.m_header.m_sourceMtime );
+
+  l_writer.add( SNAP_ACTOR_CHARS,   m_actorNames.m_chars );
+  l_writer.add( SNAP_ACTOR_OFFSETS, m_actorNames.m_offsets );
+  l_writer.add( SNAP_ACTOR_SORTED,  m_actorNames.m_sorted );
+  l_writer.add( SNAP_MOVIE_CHARS,   m_movieTable.m_names.m_chars );
+  l_writer.add( SNAP_MOVIE_OFFSETS, m_movieTable.m_names.m_offsets );
+  l_writer.add( SNAP_MOVIE_YEARS,   m_movieTable.m_years );
+  l_writer.add( SNAP_FILM_OFFSETS,  m_bip.m_movieOffsets );
+  l_writer.add( SNAP_FILM_IDS,      m_bip.m_movieIds );
+  l_writer.add( SNAP_CAST_OFFSETS,  m_bip.m_castOffsets );
+  l_writer.add( SNAP_CAST_IDS,      m_bip.m_castIds );
+
+  for( char l_edges : { 'u', 'w' } ) {
+    if( l_edges == m_useWeightedEdges[0] && !m_csr.m_offsets.empty() ) {
+      l_writer.add( adjacencySection( SNAP_CSR_OFFSETS,   l_edges ), m_csr.m_offsets );
+      l_writer.add( adjacencySection( SNAP_CSR_NEIGHBORS, l_edges ), m_csr.m_neighbors );
+      l_writer.add( adjacencySection( SNAP_CSR_WEIGHTS,   l_edges ), m_csr.m_weights );
+      l_writer.add( adjacencySection( SNAP_CSR_MOVIES,    l_edges ), m_csr.m_movies );
+
+      if( !m_landmarks.empty() ) {
+        l_writer.add( adjacencySection( SNAP_LANDMARKS,     l_edges ), m_landmarks.m_landmarks );
+        l_writer.add( adjacencySection( SNAP_LANDMARK_DIST, l_edges ), m_landmarks.m_dist );
+      }
+    } else {
+      for( uint32_t l_id = SNAP_CSR_OFFSETS; l_id <= SNAP_LANDMARK_DIST; ++l_id )
+        l_writer.carry( m_snapshot, adjacencySection( l_id, l_edges ) );
+    }
+  }
+
+  if( !m_connections.empty() ) {
+    l_writer.add( SNAP_CONNECT_PARENT, m_connections.m_parent );
+    l_writer.add( SNAP_CONNECT_YEAR,   m_connections.m_year );
+    l_writer.add( SNAP_CONNECT_DEPTH,  m_connections.m_depth );
+    l_writer.add( SNAP_CONNECT_HEAD,   m_connections.m_head );
+  } else {
+    for( uint32_t l_id = SNAP_CONNECT_PARENT; l_id <= SNAP_CONNECT_HEAD; ++l_id )
+      l_writer.carry( m_snapshot, l_id );
+  }
+
+  if( !l_writer.write( i_snapshot ) ) {
+    std::cerr << "Failed to write snapshot " << i_snapshot << "!\n";
+    return false;
+  }
+
+  std::cout << "Wrote snapshot " << i_snapshot << "\n";
+
+  return true;
+}
+
+/** Input params: Input filename and number of threads to search with
  *  Return param: Boolean
  *  Description : Loads from input actor pair file
  *
- *  Reads the input actor pair file, and calls the corresponding graph
- *  traversal algorithm for weighted/unweighted graph.
+ *  Reads the input actor pair file, then runs the corresponding graph
+ *  traversal algorithm for weighted/unweighted graph on every pair (using
+ *  i_threads threads, all hardware threads if 0) and writes the paths found
+ *  to the output in the order of the file, a chunk of pairs at a time. Pairs
+ *  whose path is in the cache are not searched again.
  */
-bool ActorGraph::loadTestPairs( const char *i_infile ) {
-  bool l_flag = false;
+bool ActorGraph::loadTestPairs( const char *i_infile,
+                                const int  &i_threads ) {
+  bool l_flag;
   int l_id1, l_id2;
   std::string l_s;
 
+  std::vector< std::pair< int, int > > l_queries;  //! Pairs to search for
+  std::vector< std::pair< int, int > > l_chunk;    //! Pairs of the chunk
+  std::vector< std::pair< int, int > > l_misses;   //! Pairs of the chunk not in the cache
+  std::vector< size_t >                l_missSlots;  //! Position of each of them in the chunk
+  std::vector< std::vector< int > >    l_paths;    //! Path found for each pair of the chunk
+  std::vector< std::vector< int > >    l_found;    //! Path found for each miss
+  std::vector< QueryStats >            l_stats;    //! Counters of each miss's search
+  QueryStats                           l_total;    //! Counters of the chunk's searches
+  std::vector< const char * >          l_answers;  //! How each pair of the chunk was answered
+  std::string                          l_line;     //! Output line being formatted
+
+  int l_mode = m_cache.mode( m_useWeightedEdges + (m_bipartite ? " bipartite " : " ") + m_search );
+
+  std::chrono::high_resolution_clock::time_point l_phase;   //! Start of the current phase
+  l_phase = std::chrono::high_resolution_clock::now();
+
   //! Open the test_pairs_file
   std::ifstream l_in( i_infile );
 
@@ -532,30 +1812,26 @@ bool ActorGraph::loadTestPairs( const char *i_infile ) {
 
     std::cout << "Computing path for (" << l_actor1 << ") -> (" << l_actor2 << ")\n";
 
+    l_flag = false;
+
     //! Get index of actor 1
-    m_ioa = m_indexOfActor.find( l_actor1 );
-    if( m_ioa == m_indexOfActor.end() ) {
+    l_id1 = findActor( l_actor1 );
+    if( l_id1 == -1 ) {
       std::cout << "Failure to locate node '" << l_actor1 << "'\n";
       l_flag = true;
-    } else
-      l_id1 = m_ioa->second;
+    }
 
     //! Get index of actor 2
-    m_ioa = m_indexOfActor.find( l_actor2 );
-    if( m_ioa == m_indexOfActor.end() ) {
+    l_id2 = findActor( l_actor2 );
+    if( l_id2 == -1 ) {
       std::cout << "Failure to locate node '" << l_actor2 << "'\n";
       l_flag = true;
-    } else
-      l_id2 = m_ioa->second;
+    }
 
     if( l_flag )
       continue;
 
-    //! Perform proper traversal corresponding to weighted/unweighted edges
-    if( m_useWeightedEdges == "u" )
-      BFSTraverse( l_id1, l_id2 );
-    else
-      DjikstraTraverse( l_id1, l_id2 );
+    l_queries.push_back( std::make_pair( l_id1, l_id2 ) );
   }
 
   if( !l_in.eof() ) {
@@ -566,30 +1842,266 @@ bool ActorGraph::loadTestPairs( const char *i_infile ) {
   //! Close file
   l_in.close();
 
+  //! Search all pairs
+  int l_threads = i_threads;
+  if( l_threads <= 0 )
+    l_threads = std::max( (int) std::thread::hardware_concurrency(), 1 );
+
+  if( l_threads > 1 )
+    std::cout << "Searching " << l_queries.size() << " pairs with " << l_threads << " threads\n";
+
+  //! Chunk by chunk, so only one chunk's paths are held before being written out
+  long long l_numVisited = 0;
+  long long l_numHub     = 0;
+  for( size_t l_begin = 0; l_begin < l_queries.size(); l_begin += g_queryChunk ) {
+    l_chunk.assign( l_queries.begin() + l_begin,
+                    l_queries.begin() + std::min( l_begin + g_queryChunk, l_queries.size() ) );
+    l_paths.resize( l_chunk.size() );
+    l_answers.assign( l_chunk.size(), "search" );
+    l_total.clear();
+
+    //! Only pairs missing from the cache are searched
+    l_misses.clear();
+    l_missSlots.clear();
+    for( size_t l_q = 0; l_q < l_chunk.size(); ++l_q ) {
+      if( m_cache.enabled() && m_cache.find( l_chunk[l_q].first, l_chunk[l_q].second, l_mode, l_paths[l_q] ) ) {
+        l_answers[l_q] = "cache";
+        continue;
+      }
+
+      //! Pairs with a hub at either end are read off its tree
+      if( m_hubs.find( l_chunk[l_q].first, l_chunk[l_q].second, l_paths[l_q] ) ) {
+        l_answers[l_q] = "hub";
+        ++l_numHub;
+        continue;
+      }
+
+      l_misses.push_back( l_chunk[l_q] );
+      l_missSlots.push_back( l_q );
+    }
+
+    if( !l_misses.empty() )
+      l_numVisited += runQueries( l_misses, l_found, l_threads, &l_stats, &l_total );
+
+    //! Metrics lines in input order (answers without a search did no traversal work)
+    for( size_t l_q = 0, l_m = 0; l_q < l_chunk.size(); ++l_q ) {
+      if( l_m < l_missSlots.size() && l_missSlots[l_m] == l_q ) {
+        logPair( l_chunk[l_q].first, l_chunk[l_q].second, l_answers[l_q], l_found[l_m], l_stats[l_m], false );
+        ++l_m;
+      } else
+        logPair( l_chunk[l_q].first, l_chunk[l_q].second, l_answers[l_q], l_paths[l_q], QueryStats() );
+    }
+
+    for( size_t l_m = 0; l_m < l_misses.size(); ++l_m ) {
+      m_cache.insert( l_misses[l_m].first, l_misses[l_m].second, l_mode, l_found[l_m] );
+      l_paths[l_missSlots[l_m]].swap( l_found[l_m] );
+    }
+
+    m_metrics.addWork( l_total );
+    m_metrics.endPhase( "query", l_phase );
+
+    //! Write output lines of successful traversals
+    for( size_t l_q = 0; l_q < l_chunk.size(); ++l_q ) {
+      if( l_paths[l_q].empty() )
+        continue;
+
+      l_line.clear();
+      formatPath( l_paths[l_q], l_line );
+      m_out.writeLine( l_line );
+    }
+
+    m_metrics.endPhase( "write", l_phase );
+  }
+
+  if( m_cache.enabled() )
+    std::cout << "Cache: " << m_cache.hits() << " hits, " << m_cache.misses() << " misses ("
+              << 100.0 * m_cache.hits() / std::max( m_cache.hits() + m_cache.misses(), 1LL )
+              << "% hits), " << m_cache.size() << " paths\n";
+
+  if( !m_hubs.empty() )
+    std::cout << "Hubs: " << l_numHub << " pairs answered from the trees\n";
+
+  if( !l_queries.empty() )
+    std::cout << "Visited " << (double) l_numVisited / l_queries.size() << " actors per pair ("
+              << (m_search.empty() ? "default" : m_search) << " search)\n";
+
+  return true;
+}
+
+/** Input params: Actor pair, how it was answered, its path, the counters of
+ *                its search and whether to add them to the totals
+ *  Return param: None
+ *  Description : Logs a pair
+ *
+ *  Length is the number of movies on the path (-1 if there is none). Pairs
+ *  sharing a search each get its counters, which the totals count once.
+ */
+void ActorGraph::logPair( const int                &i_from,
+                          const int                &i_to,
+                          const char               *i_answer,
+                          const std::vector< int > &i_path,
+                          const QueryStats         &i_stats,
+                          const bool               &i_addToTotal ) {
+  std::string l_members;
+
+  if( m_metrics.enabled() ) {
+    l_members = "\"from\":";
+    MetricsLog::appendString( m_actorNames.name( i_from ), l_members );
+    l_members += ",\"to\":";
+    MetricsLog::appendString( m_actorNames.name( i_to ), l_members );
+    l_members += ",\"answer\":\"" + std::string( i_answer ) + "\",\"length\":" +
+                 std::to_string( i_path.empty() ? -1 : (int) i_path.size() / 2 );
+  }
+
+  m_metrics.query( l_members, i_stats, i_addToTotal );
+}
+
+/** Input params: Metrics filename
+ *  Return param: Boolean
+ *  Description : Opens the metrics file
+ */
+bool ActorGraph::openMetrics( const char *i_file ) {
+  if( !m_metrics.open( i_file ) ) {
+    std::cerr << "Failed to open " << i_file << "!\n";
+    return false;
+  }
+
+  return true;
+}
+
+/** Input params: Phase name, start of the phase (passed by reference)
+ *  Return param: None
+ *  Description : Ends a phase
+ */
+void ActorGraph::endPhase( const std::string                                    &i_phase,
+                                 std::chrono::high_resolution_clock::time_point &io_start ) {
+  m_metrics.endPhase( i_phase, io_start );
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Closes the metrics
+ */
+bool ActorGraph::closeMetrics() {
+  if( !m_metrics.close() ) {
+    std::cerr << "Failed to write metrics!\n";
+    return false;
+  }
+
   return true;
 }
 
-/** Input params: Output filename
+/** Input params: Query server
  *  Return param: Boolean
- *  Description : Writes to output file
+ *  Description : Serves actor pairs
  *
- *  Writes out all the lines stored in outLines, which got populated (hopefully)
- *  during our graph traversal.
+ *  Answers each request with its path, in the output format (empty if the
+ *  actors aren't connected), from the cache, a hub's tree or a search of the
+ *  current mode. The graph stays loaded between requests, so a request only
+ *  costs its search. Each answered pair gets a metrics line, as in
+ *  loadTestPairs, written out right away so a stopped server loses none.
  */
-bool ActorGraph::writeOutLines( const char *i_outfile ) {
-  //! Open file for writing output
-  std::ofstream l_out( i_outfile );
-  if( !l_out.is_open() ) {
+bool ActorGraph::servePairs( QueryServer &io_server ) {
+  TraversalState                    l_state;
+  std::vector< int >                l_targets( 1 );
+  std::vector< std::vector< int > > l_paths;
+  std::vector< int >                l_path;
+  std::string                       l_actor1, l_actor2;
+
+  int l_mode = m_cache.mode( m_useWeightedEdges + (m_bipartite ? " bipartite " : " ") + m_search );
+
+  l_state.init( m_actorNames.size(), m_movieTable.size() );
+  l_state.m_bucketQueue.init( std::max( m_maxWeight, 0 ) );
+
+  return io_server.serve( [&]( const std::string &i_request, std::string &o_reply ) {
+    if( !QueryServer::splitPair( i_request, l_actor1, l_actor2 ) ) {
+      o_reply = "Expected actor1<TAB>actor2";
+      return false;
+    }
+
+    int l_id1 = findActor( l_actor1 );
+    int l_id2 = findActor( l_actor2 );
+    if( l_id1 == -1 || l_id2 == -1 ) {
+      o_reply = "Failure to locate node '" + (l_id1 == -1 ? l_actor1 : l_actor2) + "'";
+      return false;
+    }
+
+    const char *l_answer = "search";  //! How the pair was answered
+    QueryStats  l_stats;              //! Counters of its search (none without one)
+
+    if( m_cache.enabled() && m_cache.find( l_id1, l_id2, l_mode, l_path ) )
+      l_answer = "cache";
+    else if( m_hubs.find( l_id1, l_id2, l_path ) )
+      l_answer = "hub";
+    else {
+      QueryStats l_before = l_state.m_stats;
+      std::chrono::high_resolution_clock::time_point l_start;
+      l_start = std::chrono::high_resolution_clock::now();
+
+      l_targets[0] = l_id2;
+      findPaths( l_id1, l_targets, l_state, l_paths );
+
+      l_stats           = l_state.m_stats.since( l_before );
+      l_stats.m_micros  = std::chrono::duration< double, std::micro >( std::chrono::high_resolution_clock::now() - l_start ).count();
+      l_stats.m_targets = 1;
+
+      l_path.swap( l_paths[0] );
+      m_cache.insert( l_id1, l_id2, l_mode, l_path );
+    }
+
+    logPair( l_id1, l_id2, l_answer, l_path, l_stats );
+    m_metrics.flush();
+
+    formatPath( l_path, o_reply );
+    return true;
+  } );
+}
+
+/** Input params: Output ids instead of names or not
+ *  Return param: None
+ *  Description : Selects ids or names for the output
+ */
+void ActorGraph::useIds( const bool &i_flag ) {
+  m_idOutput = i_flag;
+}
+
+/** Input params: Output filename, output ids instead of names or not
+ *  Return param: Boolean
+ *  Description : Opens the output file
+ *
+ *  Output lines are streamed to the file as they are produced, through a
+ *  buffer written out whenever it fills up, starting with the first line.
+ */
+bool ActorGraph::openOutput( const char *i_outfile,
+                             const bool &i_ids ) {
+  if( !m_out.open( i_outfile ) ) {
     std::cerr << "Failed to open " << i_outfile << "!\n";
     return false;
   }
 
-  //! Write output
-  for( m_vit = m_outLines.begin(); m_vit != m_outLines.end(); ++m_vit )
-    l_out << *m_vit << std::endl;
+  m_idOutput = i_ids;
+  m_out.writeLine( m_idOutput ? m_idHeader : m_header );
 
-  //! Close file
-  l_out.close();
+  return true;
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Closes the output file
+ *
+ *  Writes out the lines still buffered and reports failed writes.
+ */
+bool ActorGraph::closeOutput() {
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
+
+  bool l_closed = m_out.close();
+  m_metrics.endPhase( "write", l_start );
+
+  if( !l_closed ) {
+    std::cerr << "Failed to write output!\n";
+    return false;
+  }
 
   return true;
-}
\ No newline at end of file
+}
@@ -32,6 +32,7 @@
 #ifndef ACTOR_GRAPH_H
 #define ACTOR_GRAPH_H
 
+#include <chrono>
 #include <limits>
 #include <queue>
 #include <vector>
@@ -40,69 +41,186 @@
 
 #include "ActorEdge.h"
 #include "ActorNode.hpp"
-
-//! Comparator class to be used by the priority queue in Djikstra's traversal
-class ActorComp {
-public:
-  bool operator () ( Actor * &i_lhs, Actor * &i_rhs ) const {
-    return (*i_lhs < *i_rhs);
-  }
-};
+#include "ActorCSR.hpp"
+#include "BipartiteGraph.hpp"
+#include "ConnectionIndex.hpp"
+#include "GraphSnapshot.h"
+#include "HubTrees.hpp"
+#include "LandmarkTable.hpp"
+#include "MovieTable.hpp"
+#include "NameTable.hpp"
+#include "NodePool.hpp"
+#include "OutputWriter.h"
+#include "PathCache.hpp"
+#include "QueryMetrics.hpp"
+#include "QueryServer.h"
+#include "TraversalState.hpp"
 
 //! Class representing the actual graph and its various functionalities
 class ActorGraph {
 protected:
   const std::string           m_useWeightedEdges; //! Use weighted edges or not
+  bool                        m_bipartite;        //! Traverse actor-movie graph or not
+  std::string                 m_search;           //! Search algorithm (empty for default)
+  int                         m_minWeight;        //! Least edge-weight
+  int                         m_maxWeight;        //! Greatest edge-weight
 
   std::vector< Actor * >      m_theGraph;         //! The actual graph
-  std::vector< std::string >  m_outLines;         //! Lines to be written out to file
-
-  /** Hash-map of movies and the list of actors appearing in them
-   *  < movie#@year, vector< actor > >
-   */
-  std::unordered_map< std::string, std::vector< std::string > >           m_actorsInMovie;
-  std::unordered_map< std::string, std::vector< std::string > >::iterator m_aim;
+  NodePool< Actor >           m_actorPool;        //! Storage of the actor nodes
+  NodePool< Edge >            m_edgePool;         //! Storage of the per-year edges (actorconnections)
+  ActorCSR                    m_csr;              //! Adjacency of the graph (CSR)
+  BipartiteGraph              m_bip;              //! Credits, i.e. the actor-movie graph
+  LandmarkTable               m_landmarks;        //! Landmark distances (A* traversal)
+  ConnectionIndex             m_connections;      //! Years actors got connected (actorconnections)
+  HubTrees                    m_hubs;             //! Shortest-path trees of hub actors
+  std::string                 m_header;           //! First line to output (names)
+  std::string                 m_idHeader;         //! First line to output (ids)
+  bool                        m_idOutput;         //! Output actor/movie ids instead of names
+  OutputWriter                m_out;              //! Output lines, written out as they fill up
+  bool                        m_builtCSR;         //! createGraph built the co-star adjacency (not mapped)
+  PathCache                   m_cache;            //! Paths of recent pairs
+  MetricsLog                  m_metrics;          //! Query counters and phase times
 
-  /** Hash-map of actors and the list of movies done by them
-   * < actor, vector< movie#@year > >
-   */
-  std::unordered_map< std::string, std::vector< std::string > >           m_moviesOfActor;
-  std::unordered_map< std::string, std::vector< std::string > >::iterator m_moa;
+  //! Interned movies (movie-id -> movie#@year, year)
+  MovieTable                  m_movieTable;
 
-  //! Hash-map of global actor-index and the actor-name
-  std::unordered_map< int, std::string >            m_actorAtIndex;
-  std::unordered_map< int, std::string >::iterator  m_aai;
+  //! Actor-name at each global actor-index
+  NameTable                   m_actorNames;
 
-  //! Hash-map of actor-name and global actor-index
+  //! Hash-map of actor-name and global actor-index (only while loading)
   std::unordered_map< std::string, int >            m_indexOfActor;
   std::unordered_map< std::string, int >::iterator  m_ioa;
 
+  /** Credits in file order (only while loading)
+   *  < actor-index, movie-id >
+   */
+  std::vector< std::pair< int, int > >              m_loadCredits;
+
+  //! Snapshot the arrays are viewing (if loaded from one)
+  SnapshotReader              m_snapshot;
+
   //! Various iterators
   std::unordered_map< int, Edge * >::iterator m_eit;
   std::vector< Actor * >::iterator            m_ait;
-  std::vector< std::string >::iterator        m_vit, m_sit;
 
   //! Helper function to deallocate memory from destructor
   void deleteGraph();
 
-  //! Extract year (last 4 digits) from a movie of the form: movie#@year
-  int extractYear( const std::string &i_movie );
+  //! Look up an actor's global index, assigning the next one if unseen
+  int internActor( const std::string &i_actor );
+
+  //! Look up a movie's id, assigning the next one if unseen
+  int internMovie( const std::string &i_movie,
+                   const int         &i_year );
+
+  //! Record an actor's credit in a movie (one line of the cast file)
+  void addCredit( const int &i_actor,
+                  const int &i_movie );
+
+  //! Flatten the credits into m_bip and index the names once loading is done
+  void finishLoad();
+
+  //! Global index of an actor (-1 if not present)
+  int findActor( const std::string &i_actor ) const;
+
+  //! Print size and throughput of a finished load
+  void reportLoad( const double                                         &i_bytes,
+                   const std::chrono::high_resolution_clock::time_point &i_start,
+                   const double                                         &i_scanSecs = 0 );
+
+  //! Number of co-stars of an actor (of movies in bipartite mode)
+  int degree( const int &i_actor ) const;
+
+  //! Actors with the highest degree (ties to the lower index)
+  void topActors( const int                &i_count,
+                        std::vector< int > &o_actors ) const;
+
+  //! Movie on an edge recorded by a traversal (-1 if none)
+  int movieOf( const int &i_edge ) const;
+
+  //! Build the CSR adjacency on a pool of threads (same rows for any count)
+  bool buildCSR( const int &i_threads );
+
+  //! Find neighbors and append them as the next row of a chunk of the CSR adjacency
+  void findNeighbors( const int                &i_actor,
+                            std::vector< int > &io_slot,
+                            CSRRows            &io_rows ) const;
+
+  //! Prepare the actor-movie graph instead of the CSR co-star adjacency
+  void createBipartite();
+
+  //! Trace the path ending at a node (actor) as ids (actor, movie, actor, ...)
+  void tracePath( const int                &i_from,
+                  const int                &i_to,
+                  const TraversalState     &i_state,
+                        std::vector< int > &o_path ) const;
+
+  //! Append a traced path in the output format to a line
+  void formatPath( const std::vector< int > &i_path,
+                         std::string        &io_line ) const;
+
+  //! Perform BFS traversal (unweighted) from a node until its targets are reached
+  bool BFSTraverse( const int            &i_from,
+                          TraversalState &io_state ) const;
 
-  //! Find movie on an edge lying between 2 actors
-  std::string findMovieEdge(       Actor *i_node1,
-                             const int   &i_index2 );
+  //! Perform BFS traversal (unweighted) from both nodes until they meet
+  bool bidirectionalBFSTraverse( const int            &i_from,
+                                 const int            &i_to,
+                                       TraversalState &io_state ) const;
 
-  //! Find neighbors and populate adjacency list for a node (actor)
-  void findNeighbors( const std::string                       &i_actor,
-                            std::unordered_map< int, Edge * > &io_adjEdges );
+  //! Perform direction-optimizing BFS traversal (unweighted) between 2 nodes
+  bool directionBFSTraverse( const int            &i_from,
+                             const int            &i_to,
+                                   TraversalState &io_state ) const;
 
-  //! Perform BFS traversal (unweighted) between 2 nodes (actors)
-  void BFSTraverse( const int &i_from,
-                    const int &i_to );
+  //! Perform Djikstra's traversal (weighted) from a node until its targets are settled
+  template< class Queue >
+  bool DjikstraTraverse( const int            &i_from,
+                               TraversalState &io_state,
+                               Queue          &io_toExplore ) const;
 
-  //! Perform Djikstra's traversal (weighted) between 2 nodes
-  void DjikstraTraverse( const int &i_from,
-                         const int &i_to );
+  //! Perform A* traversal between 2 nodes with landmark lower bounds
+  bool AStarTraverse( const int            &i_from,
+                      const int            &i_to,
+                            TraversalState &io_state ) const;
+
+  //! Perform BFS traversal (unweighted) over the actor-movie graph
+  bool bipartiteBFSTraverse( const int            &i_from,
+                                   TraversalState &io_state ) const;
+
+  //! Perform Djikstra's traversal (weighted) over the actor-movie graph
+  template< class Queue >
+  bool bipartiteDjikstraTraverse( const int            &i_from,
+                                        TraversalState &io_state,
+                                        Queue          &io_toExplore ) const;
+
+  //! Whether the current search heads for one target at a time
+  bool isPairSearch() const;
+
+  //! Traverse from a node with the single-source search of the current mode
+  void traverseAll( const int            &i_from,
+                          TraversalState &io_state ) const;
+
+  //! Find the paths from a node to several with the traversal of the current mode
+  void findPaths( const int                                &i_from,
+                  const std::vector< int >                 &i_targets,
+                        TraversalState                     &io_state,
+                        std::vector< std::vector< int > >  &o_paths ) const;
+
+  //! Plan a batch of pairs by source and search it on a pool of threads (paths in input order)
+  long long runQueries( const std::vector< std::pair< int, int > > &i_queries,
+                              std::vector< std::vector< int > >    &o_paths,
+                        const int                                  &i_threads,
+                              std::vector< QueryStats >            *o_stats = NULL,
+                              QueryStats                           *o_total = NULL ) const;
+
+  //! Write the metrics line of a pair
+  void logPair( const int                &i_from,
+                const int                &i_to,
+                const char               *i_answer,
+                const std::vector< int > &i_path,
+                const QueryStats         &i_stats,
+                const bool               &i_addToTotal = true );
 
 public:
   //! Constructor (by default, unweighted edges)
@@ -112,17 +230,76 @@ public:
   //! Destructor
   ~ActorGraph();
 
-  //! Creates the graph
-  void createGraph( const bool &i_createEdges = true );
+  //! Selects the actor-movie graph mode (call before createGraph)
+  void useBipartite( const bool &i_flag );
+
+  //! Selects the search algorithm (call before loadTestPairs)
+  void useSearch( const std::string &i_search );
+
+  //! Keeps the paths of up to i_capacity recent pairs (call before loadTestPairs)
+  void useCache( const size_t &i_capacity );
+
+  //! Creates the graph (building the CSR adjacency on i_threads threads)
+  bool createGraph( const bool &i_createEdges = true,
+                    const int  &i_threads = 1 );
+
+  //! Whether createGraph built the co-star adjacency rather than mapping it from a snapshot
+  bool builtCSR() const {
+    return m_builtCSR;
+  }
+
+  //! Computes the landmark distances of A* traversal (unless already loaded)
+  bool buildLandmarks( const int &i_count );
+
+  //! Computes the shortest-path trees of the listed or the top-degree hubs
+  bool buildHubs( const int  &i_count,
+                  const char *i_list = NULL,
+                  const int  &i_threads = 1 );
+
+  //! Writes every actor's distance from each hub (call after openOutput)
+  bool writeHubTable( const char *i_outfile,
+                      const int  &i_threads = 1 ) const;
 
   //! Loads the movie cast file
   bool loadFromFile( const char *i_infile );
 
-  //! Loads the file containing pairs of actors
-  bool loadTestPairs( const char *i_infile );
+  //! Loads the movie cast file through a memory mapping
+  bool loadFromMappedFile( const char *i_infile );
+
+  //! Loads the graph from a snapshot of the given cast file
+  bool loadSnapshot( const char *i_snapshot,
+                     const char *i_source );
+
+  //! Saves the loaded graph as a snapshot of the given cast file
+  bool saveSnapshot( const char *i_snapshot,
+                     const char *i_source );
+
+  //! Loads the file containing pairs of actors and finds their paths
+  bool loadTestPairs( const char *i_infile,
+                      const int  &i_threads = 1 );
+
+  //! Answers the pairs sent to a query server until it stops
+  bool servePairs( QueryServer &io_server );
+
+  //! Selects ids instead of names for the output (openOutput selects it too)
+  void useIds( const bool &i_flag );
+
+  //! Writes a JSON line per query and a summary line to a file
+  bool openMetrics( const char *i_file );
+
+  //! Adds the time since io_start to a phase (load, build, ...) and restarts io_start
+  void endPhase( const std::string                                    &i_phase,
+                       std::chrono::high_resolution_clock::time_point &io_start );
+
+  //! Prints the phase times and writes the summary line
+  bool closeMetrics();
+
+  //! Opens the output file and writes the first line (names or ids)
+  bool openOutput( const char *i_outfile,
+                   const bool &i_ids = false );
 
-  //! Writes out final output lines to file
-  bool writeOutLines( const char *i_outfile );
+  //! Writes out the remaining output lines and closes the file
+  bool closeOutput();
 };
 
 #endif // ACTORGRAPH_H
\ No newline at end of file
@@ -36,17 +36,7 @@
 //! Node in graph representing an actor
 struct Actor {
   int                               m_index;  //! Global actor index
-  int                               m_dist;   //! Distance from source
-  int                               m_prev;   //! Previous actor's index
-  bool                              m_done;   //! Discovery flag (for Djikstra's)
-  std::unordered_map< int, Edge * > m_adj;    //! Adjacency list (neighbor-index, edge)
-
-  /** '<' operator overloaded to compare actors based on their distance i.e.
-   *  lesser distance has higher priority in the priority queue for Djikstra's
-   */
-  bool operator < ( const Actor &i_other ) {
-    return (this->m_dist >= i_other.m_dist);
-  }
+  std::unordered_map< int, Edge * > m_adj;    //! Per-year adjacency list (neighbor-index, edge)
 };
 
 #endif //! ACTORNODE_H
@@ -0,0 +1,71 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct BipartiteGraph, the actor-movie (two node kinds)
+ * representation of the graph, which also holds the credits of every actor.
+ **/
+
+#ifndef BIPARTITE_GRAPH_HPP
+#define BIPARTITE_GRAPH_HPP
+
+#include <vector>
+
+#include "MappedArray.hpp"
+
+/** Actor-movie bipartite graph over movie-ids. Movies of actor i occupy
+ *  m_movieIds[m_movieOffsets[i] .. m_movieOffsets[i + 1]) and the cast of
+ *  movie j occupies m_castIds[m_castOffsets[j] .. m_castOffsets[j + 1]), so
+ *  the edge count is linear in the number of credits rather than quadratic in
+ *  the cast sizes. Both lists keep the order of the cast file; they are built
+ *  at load time and every graph mode reads the credits from here.
+ */
+struct BipartiteGraph {
+  MappedArray< int >  m_movieOffsets; //! Filmography offsets (size: actors + 1)
+  MappedArray< int >  m_movieIds;     //! Movie indices of all filmographies
+  MappedArray< int >  m_castOffsets;  //! Cast offsets (size: movies + 1)
+  MappedArray< int >  m_castIds;      //! Actor indices of all casts
+  std::vector< int >  m_movieWeights; //! Edge-weight through each movie (bipartite mode)
+
+  //! Number of movie nodes
+  int numMovies() const {
+    return m_castOffsets.empty() ? 0 : (int) m_castOffsets.size() - 1;
+  }
+
+  //! Number of actor-movie credits stored
+  size_t numCredits() const {
+    return m_castIds.size();
+  }
+
+  //! Bytes held by the arrays
+  size_t bytes() const {
+    return (m_movieOffsets.size() + m_movieIds.size() +
+            m_castOffsets.size()  + m_castIds.size()  +
+            m_movieWeights.size()) * sizeof( int );
+  }
+};
+
+#endif //! BIPARTITE_GRAPH_HPP
@@ -0,0 +1,240 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of class CastLoader's member functions required to
+ * memory-map a movie cast file and split it into records.
+ **/
+
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CastLoader.h"
+
+/** Input params: Other reference
+ *  Return param: Boolean
+ *  Description : Compares the referenced bytes
+ */
+bool StrRef::operator == ( const StrRef &i_other ) const {
+  return (m_len == i_other.m_len) && (std::memcmp( m_ptr, i_other.m_ptr, m_len ) == 0);
+}
+
+/** Input params: Reference
+ *  Return param: Hash value
+ *  Description : FNV-1a hash of the referenced bytes
+ */
+size_t StrRefHash::operator () ( const StrRef &i_ref ) const {
+  unsigned long long l_hash = 14695981039346656037ULL;
+
+  for( size_t l_i = 0; l_i < i_ref.m_len; ++l_i ) {
+    l_hash ^= (unsigned char) i_ref.m_ptr[l_i];
+    l_hash *= 1099511628211ULL;
+  }
+
+  return (size_t) l_hash;
+}
+
+/** Input params: Year column [i_first, i_last), year (passed by reference)
+ *  Return param: Boolean
+ *  Description : Parses a year
+ *
+ *  Accepts an optional '-' followed by 1 to 9 digits and nothing else but a
+ *  trailing '\r' (CRLF files), so both loaders reject the same lines rather
+ *  than reading an empty or non-numeric column as year 0.
+ */
+bool CastLoader::parseYear( const char *i_first,
+                            const char *i_last,
+                                  int  &o_year ) {
+  const char *l_p   = i_first;
+  bool        l_neg = (l_p < i_last && *l_p == '-');
+
+  if( l_neg )
+    l_p++;
+
+  if( i_last > l_p && i_last[-1] == '\r' )
+    i_last--;
+
+  if( l_p == i_last || i_last - l_p > 9 )
+    return false;
+
+  o_year = 0;
+  for( ; l_p < i_last; ++l_p ) {
+    if( *l_p < '0' || *l_p > '9' )
+      return false;
+
+    o_year = o_year * 10 + (*l_p - '0');
+  }
+
+  if( l_neg )
+    o_year = -o_year;
+
+  return true;
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Constructor
+ */
+CastLoader::CastLoader() : m_fd(-1), m_data(NULL), m_size(0), m_skipped(0) {}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Destructor
+ */
+CastLoader::~CastLoader() {
+  unmap();
+}
+
+/** Input params: Input filename
+ *  Return param: Boolean
+ *  Description : Memory-maps the file
+ *
+ *  Maps the whole file read-only; an empty file maps to no data.
+ */
+bool CastLoader::map( const char *i_infile ) {
+  struct stat l_st;
+
+  m_fd = open( i_infile, O_RDONLY );
+  if( m_fd == -1 )
+    return false;
+
+  if( fstat( m_fd, &l_st ) == -1 ) {
+    unmap();
+    return false;
+  }
+
+  m_size = (size_t) l_st.st_size;
+  if( m_size == 0 )
+    return true;
+
+  void *l_addr = mmap( NULL, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0 );
+  if( l_addr == MAP_FAILED ) {
+    m_size = 0;
+    unmap();
+    return false;
+  }
+
+  //! The file is read front to back exactly once
+  madvise( l_addr, m_size, MADV_SEQUENTIAL );
+  m_data = (const char *) l_addr;
+
+  return true;
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Splits the mapped file into records
+ *
+ *  Lines and columns are found with memchr, which glibc implements with
+ *  vector instructions, so the scan runs at close to memory bandwidth. Lines
+ *  that don't have exactly 3 columns are skipped, like loadFromFile does, and
+ *  so are (with their line number reported) lines whose year isn't a number.
+ */
+void CastLoader::scan() {
+  const char *l_pos = m_data;
+  const char *l_end = m_data + m_size;
+  const char *l_eol, *l_tab1, *l_tab2;
+  CastRecord  l_rec;
+  size_t      l_lines = 0;
+  size_t      l_line  = 1;    //! Line number (the header is line 1)
+
+  m_records.clear();
+  m_skipped = 0;
+
+  if( m_data == NULL )
+    return;
+
+  //! Count lines first so that the records array is allocated once
+  for( const char *l_p = l_pos; (l_p = (const char *) std::memchr( l_p, '\n', l_end - l_p )) != NULL; ++l_p )
+    l_lines++;
+
+  m_records.reserve( l_lines + 1 );
+
+  //! Skip first line (i.e. Actor/Actress	Movie	Year)
+  l_eol = (const char *) std::memchr( l_pos, '\n', l_end - l_pos );
+  l_pos = (l_eol == NULL) ? l_end : l_eol + 1;
+
+  while( l_pos < l_end ) {
+    l_line++;
+    l_eol = (const char *) std::memchr( l_pos, '\n', l_end - l_pos );
+    if( l_eol == NULL )
+      l_eol = l_end;
+
+    //! Exactly 2 tabs on the line
+    l_tab1 = (const char *) std::memchr( l_pos, '\t', l_eol - l_pos );
+    l_tab2 = (l_tab1 == NULL) ? NULL :
+             (const char *) std::memchr( l_tab1 + 1, '\t', l_eol - l_tab1 - 1 );
+
+    if( l_tab2 == NULL || std::memchr( l_tab2 + 1, '\t', l_eol - l_tab2 - 1 ) != NULL ) {
+      if( l_eol != l_pos )
+        m_skipped++;
+
+      l_pos = l_eol + 1;
+      continue;
+    }
+
+    l_rec.m_actor.m_ptr     = l_pos;
+    l_rec.m_actor.m_len     = l_tab1 - l_pos;
+    l_rec.m_title.m_ptr     = l_tab1 + 1;
+    l_rec.m_title.m_len     = l_tab2 - l_tab1 - 1;
+    l_rec.m_movieKey.m_ptr  = l_tab1 + 1;
+    l_rec.m_movieKey.m_len  = l_eol - l_tab1 - 1;
+
+    //! Parse the year in place
+    if( !parseYear( l_tab2 + 1, l_eol, l_rec.m_year ) ) {
+      std::cerr << "Skipping line " << l_line << ": year '" << std::string( l_tab2 + 1, l_eol )
+                << "' is not a number\n";
+      m_skipped++;
+
+      l_pos = l_eol + 1;
+      continue;
+    }
+
+    m_records.push_back( l_rec );
+    l_pos = l_eol + 1;
+  }
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Unmaps the file
+ */
+void CastLoader::unmap() {
+  if( m_data != NULL )
+    munmap( (void *) m_data, m_size );
+
+  if( m_fd != -1 )
+    close( m_fd );
+
+  m_fd    = -1;
+  m_data  = NULL;
+  m_size  = 0;
+  m_records.clear();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class CastLoader, a zero-copy reader of movie cast files
+ * that memory-maps the file and splits it into records without copying.
+ **/
+
+#ifndef CAST_LOADER_H
+#define CAST_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//! Non-owning reference to bytes of the mapped file
+struct StrRef {
+  const char *m_ptr;  //! First byte
+  size_t      m_len;  //! Number of bytes
+
+  //! Copy the referenced bytes into a string
+  std::string str() const {
+    return std::string( m_ptr, m_len );
+  }
+
+  bool operator == ( const StrRef &i_other ) const;
+};
+
+//! Hash of the referenced bytes (FNV-1a), for hash-maps keyed on StrRef
+struct StrRefHash {
+  size_t operator () ( const StrRef &i_ref ) const;
+};
+
+//! One line of the movie cast file (Actor/Actress	Movie	Year)
+struct CastRecord {
+  StrRef m_actor;     //! Actor name
+  StrRef m_title;     //! Movie title
+  StrRef m_movieKey;  //! Movie title, tab and year (unique per movie#@year)
+  int    m_year;      //! Year parsed from the third column
+};
+
+//! Class mapping a movie cast file and splitting it into records
+class CastLoader {
+private:
+  int                       m_fd;       //! File descriptor
+  const char               *m_data;     //! Mapped file contents
+  size_t                    m_size;     //! Size of the file in bytes
+  std::vector< CastRecord > m_records;  //! Records referencing m_data
+  size_t                    m_skipped;  //! Lines without exactly 3 columns or a numeric year
+
+public:
+  //! Constructor
+  CastLoader();
+
+  //! Destructor (unmaps the file)
+  ~CastLoader();
+
+  //! Memory-maps the file
+  bool map( const char *i_infile );
+
+  //! Splits the mapped file into records (skipping the header line)
+  void scan();
+
+  //! Unmaps the file, invalidating all records
+  void unmap();
+
+  //! Size of the mapped file in bytes
+  size_t size() const {
+    return m_size;
+  }
+
+  //! Number of malformed lines skipped by scan
+  size_t skipped() const {
+    return m_skipped;
+  }
+
+  //! Records found by scan
+  const std::vector< CastRecord > &records() const {
+    return m_records;
+  }
+
+  //! Parse a year column (false unless it is an optional '-' and 1 to 9 digits)
+  static bool parseYear( const char *i_first,
+                         const char *i_last,
+                               int  &o_year );
+};
+
+#endif //! CAST_LOADER_H
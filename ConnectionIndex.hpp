@@ -0,0 +1,85 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct ConnectionIndex, the Kruskal reconstruction tree
+ * answering after which year 2 actors got connected.
+ **/
+
+#ifndef CONNECTION_INDEX_HPP
+#define CONNECTION_INDEX_HPP
+
+#include <utility>
+
+#include "MappedArray.hpp"
+
+/** Kruskal reconstruction tree of the union-find sweep over the years. The
+ *  actors are its leaves (0 ... n-1) and every union of 2 disjoint sets adds
+ *  a node (n, n+1, ...) with both sets' top nodes as children, labelled with
+ *  the year of the union. Years never decrease towards the root, so 2 actors
+ *  got connected in the year of their lowest common ancestor. The tree is cut
+ *  into heavy paths (each node continuing the path of its larger child), which
+ *  finds that ancestor by crossing O(log n) paths.
+ */
+struct ConnectionIndex {
+  MappedArray< int >  m_parent; //! Parent of each node (-1 at a root)
+  MappedArray< int >  m_year;   //! Year of each union (earliest year at the leaves)
+  MappedArray< int >  m_depth;  //! Depth of each node
+  MappedArray< int >  m_head;   //! Top node of each node's heavy path
+
+  int numNodes() const {
+    return (int) m_parent.size();
+  }
+
+  bool empty() const {
+    return m_parent.empty();
+  }
+
+  //! Bytes held by the arrays
+  size_t bytes() const {
+    return (m_parent.size() + m_year.size() + m_depth.size() + m_head.size()) * sizeof( int );
+  }
+
+  //! Year 2 actors got connected (-1 if never)
+  int connectedSince( int i_actor1,
+                      int i_actor2 ) const {
+    //! Climb from the node whose path starts deeper until both are on one path
+    while( m_head[i_actor1] != m_head[i_actor2] ) {
+      if( m_depth[m_head[i_actor1]] < m_depth[m_head[i_actor2]] )
+        std::swap( i_actor1, i_actor2 );
+
+      //! Both paths start at (different) roots
+      if( m_parent[m_head[i_actor1]] == -1 )
+        return -1;
+
+      i_actor1 = m_parent[m_head[i_actor1]];
+    }
+
+    return m_year[m_depth[i_actor1] < m_depth[i_actor2] ? i_actor1 : i_actor2];
+  }
+};
+
+#endif //! CONNECTION_INDEX_HPP
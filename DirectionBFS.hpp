@@ -0,0 +1,226 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class DirectionBFS, a direction-optimizing breadth-first
+ * search over bitmap frontiers.
+ **/
+
+#ifndef DIRECTION_BFS_HPP
+#define DIRECTION_BFS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/** Level-synchronous BFS that switches between top-down steps (the frontier
+ *  scans its neighbors) and bottom-up steps (every unvisited actor looks for
+ *  a neighbor in the frontier, stopping at the first one). Bottom-up pays off
+ *  once the frontier holds a large share of the remaining edges, which on the
+ *  co-star graph happens as soon as a hub is reached (Beamer et al.).
+ *
+ *  Adjacency needs to provide
+ *    int       numNodes() const
+ *    long long numEdges() const          (directed edges)
+ *    int       degree( int ) const
+ *    bool      scan( int, F ) const      (calls F( neighbor, edge ) until it returns true)
+ *
+ *  where edge identifies the edge to the neighbor for the caller, e.g. its
+ *  position in the adjacency.
+ *
+ *  The scratch arrays are sized on first use and reused by later searches.
+ */
+class DirectionBFS {
+protected:
+  std::vector< uint64_t > m_visited;    //! Visited bitmap
+  std::vector< uint64_t > m_frontier;   //! Bitmap of the current level
+  std::vector< uint64_t > m_nextBits;   //! Bitmap of the level being discovered
+  std::vector< int >      m_queue;      //! Actors of the current level
+  std::vector< int >      m_nextQueue;  //! Actors of the level being discovered
+  std::vector< int >      m_parent;     //! Actor a node was discovered from
+  std::vector< int >      m_parentEdge; //! Edge a node was discovered through
+  int                     m_numBottomUp;  //! Bottom-up steps taken by the last search
+  int                     m_numVisited;   //! Actors visited by the last search
+  long long               m_numExpanded;  //! Frontier actors of the last search's levels
+  long long               m_numScanned;   //! Neighbors looked at by the last search
+
+  static const int ALPHA = 14;  //! Go bottom-up when frontier edges > unexplored edges / ALPHA
+  static const int BETA  = 24;  //! Go top-down again when frontier actors < actors / BETA
+
+  static bool test( const std::vector< uint64_t > &i_bits,
+                    const int                     &i_node ) {
+    return (i_bits[i_node >> 6] >> (i_node & 63)) & 1;
+  }
+
+  static void set( std::vector< uint64_t > &io_bits,
+                   const int               &i_node ) {
+    io_bits[i_node >> 6] |= (uint64_t) 1 << (i_node & 63);
+  }
+
+public:
+  DirectionBFS() : m_numBottomUp(0), m_numVisited(0), m_numExpanded(0), m_numScanned(0) {}
+
+  //! Actor a node was discovered from in the last search (-1 for its source)
+  int parent( const int &i_node ) const {
+    return m_parent[i_node];
+  }
+
+  //! Edge a node was discovered through in the last search (-1 for its source)
+  int parentEdge( const int &i_node ) const {
+    return m_parentEdge[i_node];
+  }
+
+  //! Bottom-up steps taken by the last search
+  int numBottomUp() const {
+    return m_numBottomUp;
+  }
+
+  //! Actors visited by the last search
+  int numVisited() const {
+    return m_numVisited;
+  }
+
+  //! Frontier actors of the last search's levels
+  long long numExpanded() const {
+    return m_numExpanded;
+  }
+
+  //! Neighbors looked at by the last search (bottom-up steps stop at the first one in the frontier)
+  long long numScanned() const {
+    return m_numScanned;
+  }
+
+  //! Search from i_from until i_to is reached (returns false if it never is)
+  template< class Adjacency >
+  bool search( const Adjacency &i_graph,
+               const int       &i_from,
+               const int       &i_to ) {
+    int       l_numNodes  = i_graph.numNodes();
+    size_t    l_numWords  = (l_numNodes + 63) / 64;
+    bool      l_bottomUp  = false;
+    long long l_frontierEdges   = i_graph.degree( i_from );               //! Edges out of the frontier
+    long long l_unexploredEdges = i_graph.numEdges() - l_frontierEdges;   //! Edges out of unvisited actors
+
+    if( m_parent.size() != (size_t) l_numNodes ) {
+      m_parent.assign( l_numNodes, -1 );
+      m_parentEdge.assign( l_numNodes, -1 );
+      m_visited.assign( l_numWords, 0 );
+      m_frontier.assign( l_numWords, 0 );
+      m_nextBits.assign( l_numWords, 0 );
+    } else {
+      std::fill( m_visited.begin(), m_visited.end(), 0 );
+      std::fill( m_frontier.begin(), m_frontier.end(), 0 );
+    }
+
+    m_numBottomUp = 0;
+    m_numVisited  = 1;
+    m_numExpanded = 0;
+    m_numScanned  = 0;
+    m_queue.clear();
+
+    //! Intial node conditioning
+    m_parent[i_from] = -1;
+    m_parentEdge[i_from] = -1;
+    set( m_visited, i_from );
+    set( m_frontier, i_from );
+    m_queue.push_back( i_from );
+
+    if( i_from == i_to )
+      return true;
+
+    while( !m_queue.empty() ) {
+      //! Pick the direction of this step
+      if( !l_bottomUp && l_frontierEdges > l_unexploredEdges / ALPHA )
+        l_bottomUp = true;
+      else if( l_bottomUp && (long long) m_queue.size() < l_numNodes / BETA )
+        l_bottomUp = false;
+
+      m_nextQueue.clear();
+      m_numExpanded += (long long) m_queue.size();
+      std::fill( m_nextBits.begin(), m_nextBits.end(), 0 );
+
+      if( l_bottomUp ) {
+        ++m_numBottomUp;
+
+        //! Every unvisited actor adopts the first neighbor found in the frontier
+        for( int l_node = 0; l_node < l_numNodes; ++l_node ) {
+          if( test( m_visited, l_node ) )
+            continue;
+
+          i_graph.scan( l_node, [&]( const int &i_neighbor,
+                                     const int &i_edge ) {
+            ++m_numScanned;
+            if( !test( m_frontier, i_neighbor ) )
+              return false;
+
+            m_parent[l_node] = i_neighbor;
+            m_parentEdge[l_node] = i_edge;
+            set( m_visited, l_node );
+            m_nextQueue.push_back( l_node );
+            set( m_nextBits, l_node );
+            return true;
+          } );
+        }
+      } else {
+        //! Every frontier actor discovers its unvisited neighbors
+        for( int l_node : m_queue ) {
+          m_numScanned += i_graph.degree( l_node );
+          i_graph.scan( l_node, [&]( const int &i_neighbor,
+                                     const int &i_edge ) {
+            if( !test( m_visited, i_neighbor ) ) {
+              m_parent[i_neighbor] = l_node;
+              m_parentEdge[i_neighbor] = i_edge;
+              set( m_visited, i_neighbor );
+              m_nextQueue.push_back( i_neighbor );
+              set( m_nextBits, i_neighbor );
+            }
+
+            return false;
+          } );
+        }
+      }
+
+      m_numVisited += (int) m_nextQueue.size();
+
+      if( test( m_visited, i_to ) )
+        return true;
+
+      //! The new level becomes the frontier
+      m_queue.swap( m_nextQueue );
+      m_frontier.swap( m_nextBits );
+
+      l_frontierEdges = 0;
+      for( int l_node : m_queue )
+        l_frontierEdges += i_graph.degree( l_node );
+
+      l_unexploredEdges -= l_frontierEdges;
+    }
+
+    return false;
+  }
+};
+
+#endif //! DIRECTION_BFS_HPP
@@ -0,0 +1,205 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration and implementation of the templated disjoint set (union-find)
+ * and its union and path compression policies.
+ **/
+
+#ifndef DISJOINT_SET_HPP
+#define DISJOINT_SET_HPP
+
+#include <utility>
+#include <vector>
+
+/** Union policies: link the roots of 2 disjoint sets, keeping some per-root
+ *  count in io_aux so that trees stay shallow, and return the new root.
+ */
+
+//! Union by size: the root of the smaller set goes under the larger one
+struct UnionBySize {
+  template< typename IndexT >
+  static void init( std::vector< IndexT > &o_aux,
+                    const IndexT          &i_size ) {
+    o_aux.assign( i_size, 1 );
+  }
+
+  template< typename IndexT >
+  static IndexT link( std::vector< IndexT > &io_parent,
+                      std::vector< IndexT > &io_aux,
+                      IndexT                 i_root1,
+                      IndexT                 i_root2 ) {
+    if( io_aux[i_root1] < io_aux[i_root2] )
+      std::swap( i_root1, i_root2 );
+
+    io_parent[i_root2] = i_root1;
+    io_aux[i_root1]   += io_aux[i_root2];
+    return i_root1;
+  }
+};
+
+//! Union by rank: the root of lower rank (height bound) goes under the other
+struct UnionByRank {
+  template< typename IndexT >
+  static void init( std::vector< IndexT > &o_aux,
+                    const IndexT          &i_size ) {
+    o_aux.assign( i_size, 0 );
+  }
+
+  template< typename IndexT >
+  static IndexT link( std::vector< IndexT > &io_parent,
+                      std::vector< IndexT > &io_aux,
+                      IndexT                 i_root1,
+                      IndexT                 i_root2 ) {
+    if( io_aux[i_root1] < io_aux[i_root2] )
+      std::swap( i_root1, i_root2 );
+    else if( io_aux[i_root1] == io_aux[i_root2] )
+      ++io_aux[i_root1];
+
+    io_parent[i_root2] = i_root1;
+    return i_root1;
+  }
+};
+
+/** Compression policies: find the root of a node, shortening the path to it
+ *  on the way without allocating.
+ */
+
+//! Path halving: every other node on the path skips to its grandparent
+struct PathHalving {
+  template< typename IndexT >
+  static IndexT find( std::vector< IndexT > &io_parent,
+                      IndexT                 i_node ) {
+    while( io_parent[i_node] != i_node ) {
+      io_parent[i_node] = io_parent[io_parent[i_node]];
+      i_node            = io_parent[i_node];
+    }
+
+    return i_node;
+  }
+};
+
+//! Path splitting: every node on the path skips to its grandparent
+struct PathSplitting {
+  template< typename IndexT >
+  static IndexT find( std::vector< IndexT > &io_parent,
+                      IndexT                 i_node ) {
+    while( io_parent[i_node] != i_node ) {
+      IndexT l_next     = io_parent[i_node];
+      io_parent[i_node] = io_parent[l_next];
+      i_node            = l_next;
+    }
+
+    return i_node;
+  }
+};
+
+//! Full path compression: a second pass points every node on the path at the root
+struct FullCompression {
+  template< typename IndexT >
+  static IndexT find( std::vector< IndexT > &io_parent,
+                      IndexT                 i_node ) {
+    IndexT l_root = i_node;
+    while( io_parent[l_root] != l_root )
+      l_root = io_parent[l_root];
+
+    while( io_parent[i_node] != l_root ) {
+      IndexT l_next     = io_parent[i_node];
+      io_parent[i_node] = l_root;
+      i_node            = l_next;
+    }
+
+    return l_root;
+  }
+};
+
+//! No compression: only the union policy keeps paths short
+struct NoCompression {
+  template< typename IndexT >
+  static IndexT find( std::vector< IndexT > &io_parent,
+                      IndexT                 i_node ) {
+    while( io_parent[i_node] != i_node )
+      i_node = io_parent[i_node];
+
+    return i_node;
+  }
+};
+
+//! Disjoint sets of the nodes 0 ... size-1 (each node its own set at first)
+template< typename IndexT,
+          class UnionPolicy       = UnionBySize,
+          class CompressionPolicy = PathHalving >
+class DisjointSet {
+private:
+  std::vector< IndexT > m_parent; //! Parent of each node (itself at a root)
+  std::vector< IndexT > m_aux;    //! Size or rank of each root
+
+public:
+  //! Constructor
+  DisjointSet( const IndexT &i_size = 0 ) {
+    reset( i_size );
+  }
+
+  //! Make every node its own set again
+  void reset( const IndexT &i_size ) {
+    m_parent.resize( i_size );
+    for( IndexT l_node = 0; l_node < i_size; ++l_node )
+      m_parent[l_node] = l_node;
+
+    UnionPolicy::init( m_aux, i_size );
+  }
+
+  //! Number of nodes
+  IndexT size() const {
+    return (IndexT) m_parent.size();
+  }
+
+  //! Root of the set holding a node
+  IndexT find( const IndexT &i_node ) {
+    return CompressionPolicy::find( m_parent, i_node );
+  }
+
+  //! Unite the sets of 2 nodes (false if they were one already)
+  bool unite( const IndexT &i_node1,
+              const IndexT &i_node2 ) {
+    IndexT l_root1 = find( i_node1 );
+    IndexT l_root2 = find( i_node2 );
+
+    if( l_root1 == l_root2 )
+      return false;
+
+    UnionPolicy::link( m_parent, m_aux, l_root1, l_root2 );
+    return true;
+  }
+
+  //! Same set or not
+  bool same( const IndexT &i_node1,
+             const IndexT &i_node2 ) {
+    return find( i_node1 ) == find( i_node2 );
+  }
+};
+
+#endif //! DISJOINT_SET_HPP
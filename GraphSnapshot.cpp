@@ -0,0 +1,326 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of classes SnapshotWriter and SnapshotReader required to
+ * save the graph to a snapshot and memory-map it back.
+ **/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "GraphSnapshot.h"
+
+//! Magic bytes identifying a snapshot
+static const char g_snapshotMagic[8] = { 'S', 'D', 'K', 'B', 'S', 'N', 'A', 'P' };
+
+//! Alignment of every section in the file
+static const uint64_t g_sectionAlign = 64;
+
+/** Input params: Filename, size and modification time (passed by reference)
+ *  Return param: Boolean
+ *  Description : Stamp of a file
+ */
+bool sourceStamp( const char *i_file,
+                  uint64_t   &o_size,
+                  int64_t    &o_mtime ) {
+  struct stat l_st;
+
+  if( stat( i_file, &l_st ) == -1 )
+    return false;
+
+  o_size  = (uint64_t) l_st.st_size;
+  o_mtime = (int64_t) l_st.st_mtime;
+
+  return true;
+}
+
+/** Input params: Section id (unweighted), u/w
+ *  Return param: Section id
+ *  Description : Section of the co-star adjacency of u/w edges
+ *
+ *  The adjacency and its landmarks are stored once per kind of edges, so
+ *  runs with u and with w share a snapshot without rebuilding each other's.
+ */
+uint32_t adjacencySection( const uint32_t &i_id,
+                           const char     &i_edges ) {
+  return (i_edges == 'w') ? i_id + (SNAP_W_CSR_OFFSETS - SNAP_CSR_OFFSETS) : i_id;
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Constructor
+ */
+SnapshotWriter::SnapshotWriter() {
+  std::memset( &m_header, 0, sizeof( m_header ) );
+  std::memcpy( m_header.m_magic, g_snapshotMagic, sizeof( g_snapshotMagic ) );
+  m_header.m_version = SNAPSHOT_VERSION;
+}
+
+/** Input params: Section id, element size, element count and data
+ *  Return param: None
+ *  Description : Adds a section (offsets are assigned by write)
+ */
+void SnapshotWriter::addRaw( const uint32_t &i_id,
+                             const uint32_t &i_elemSize,
+                             const uint64_t &i_count,
+                             const void     *i_data ) {
+  SnapshotSection l_sec;
+
+  l_sec.m_id        = i_id;
+  l_sec.m_elemSize  = i_elemSize;
+  l_sec.m_offset    = 0;
+  l_sec.m_count     = i_count;
+
+  m_sections.push_back( l_sec );
+  m_data.push_back( i_data );
+}
+
+/** Input params: Mapped snapshot, section id
+ *  Return param: None
+ *  Description : Carries a section over from a mapped snapshot
+ */
+void SnapshotWriter::carry( const SnapshotReader &i_reader,
+                            const uint32_t       &i_id ) {
+  uint32_t    l_elemSize;
+  uint64_t    l_count;
+  const void *l_data;
+
+  if( i_reader.raw( i_id, l_elemSize, l_count, l_data ) )
+    addRaw( i_id, l_elemSize, l_count, l_data );
+}
+
+/** Input params: Output filename
+ *  Return param: Boolean
+ *  Description : Writes the snapshot
+ *
+ *  Lays out header, section table and 64-byte aligned sections, writes them
+ *  to a temporary file and renames it over i_file, so a reader never maps a
+ *  half-written snapshot.
+ */
+bool SnapshotWriter::write( const char *i_file ) {
+  std::string l_tmp = std::string( i_file ) + ".tmp";
+  uint64_t    l_pos;
+  char        l_zeros[g_sectionAlign] = { 0 };
+
+  m_header.m_numSections = (uint32_t) m_sections.size();
+
+  //! Assign aligned offsets after the header and section table
+  l_pos = sizeof( SnapshotHeader ) + m_sections.size() * sizeof( SnapshotSection );
+  for( size_t l_i = 0; l_i < m_sections.size(); ++l_i ) {
+    l_pos = (l_pos + g_sectionAlign - 1) / g_sectionAlign * g_sectionAlign;
+    m_sections[l_i].m_offset = l_pos;
+    l_pos += m_sections[l_i].m_count * m_sections[l_i].m_elemSize;
+  }
+
+  std::ofstream l_out( l_tmp.c_str(), std::ios::binary );
+  if( !l_out.is_open() )
+    return false;
+
+  l_out.write( (const char *) &m_header, sizeof( m_header ) );
+  if( !m_sections.empty() )
+    l_out.write( (const char *) &m_sections[0], m_sections.size() * sizeof( SnapshotSection ) );
+
+  l_pos = sizeof( SnapshotHeader ) + m_sections.size() * sizeof( SnapshotSection );
+  for( size_t l_i = 0; l_i < m_sections.size(); ++l_i ) {
+    l_out.write( l_zeros, m_sections[l_i].m_offset - l_pos );
+    l_out.write( (const char *) m_data[l_i], m_sections[l_i].m_count * m_sections[l_i].m_elemSize );
+    l_pos = m_sections[l_i].m_offset + m_sections[l_i].m_count * m_sections[l_i].m_elemSize;
+  }
+
+  l_out.close();
+  if( !l_out ) {
+    std::remove( l_tmp.c_str() );
+    return false;
+  }
+
+  return std::rename( l_tmp.c_str(), i_file ) == 0;
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Constructor
+ */
+SnapshotReader::SnapshotReader() : m_fd(-1), m_data(NULL), m_size(0), m_sections(NULL) {}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Destructor
+ */
+SnapshotReader::~SnapshotReader() {
+  close();
+}
+
+/** Input params: Snapshot filename and error message (passed by reference)
+ *  Return param: Boolean
+ *  Description : Maps a snapshot
+ *
+ *  Checks magic, version and that every section lies inside the file and is
+ *  aligned for its element size before any view is handed out.
+ */
+bool SnapshotReader::open( const char  *i_file,
+                           std::string &o_error ) {
+  struct stat l_st;
+
+  close();
+
+  m_fd = ::open( i_file, O_RDONLY );
+  if( m_fd == -1 || fstat( m_fd, &l_st ) == -1 ) {
+    o_error = "cannot open";
+    close();
+    return false;
+  }
+
+  m_size = (size_t) l_st.st_size;
+  if( m_size < sizeof( SnapshotHeader ) ) {
+    o_error = "too small";
+    close();
+    return false;
+  }
+
+  void *l_addr = mmap( NULL, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0 );
+  if( l_addr == MAP_FAILED ) {
+    o_error = "cannot map";
+    m_size  = 0;
+    close();
+    return false;
+  }
+
+  m_data = (const char *) l_addr;
+
+  const SnapshotHeader &l_header = header();
+  if( std::memcmp( l_header.m_magic, g_snapshotMagic, sizeof( g_snapshotMagic ) ) != 0 ) {
+    o_error = "not a snapshot";
+    close();
+    return false;
+  }
+
+  if( l_header.m_version != SNAPSHOT_VERSION ) {
+    o_error = "version " + std::to_string( l_header.m_version ) + ", expected " +
+              std::to_string( SNAPSHOT_VERSION );
+    close();
+    return false;
+  }
+
+  uint64_t l_table = sizeof( SnapshotHeader ) + (uint64_t) l_header.m_numSections * sizeof( SnapshotSection );
+  if( l_table > m_size ) {
+    o_error = "truncated section table";
+    close();
+    return false;
+  }
+
+  m_sections = (const SnapshotSection *) (m_data + sizeof( SnapshotHeader ));
+
+  for( uint32_t l_i = 0; l_i < l_header.m_numSections; ++l_i ) {
+    const SnapshotSection &l_sec = m_sections[l_i];
+
+    if( l_sec.m_elemSize == 0 || l_sec.m_offset % l_sec.m_elemSize != 0 ||
+        l_sec.m_offset > m_size ||
+        l_sec.m_count > (m_size - l_sec.m_offset) / l_sec.m_elemSize ) {
+      o_error = "corrupt section " + std::to_string( l_sec.m_id );
+      close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Unmaps the snapshot
+ */
+void SnapshotReader::close() {
+  if( m_data != NULL )
+    munmap( (void *) m_data, m_size );
+
+  if( m_fd != -1 )
+    ::close( m_fd );
+
+  m_fd        = -1;
+  m_data      = NULL;
+  m_size      = 0;
+  m_sections  = NULL;
+}
+
+/** Input params: Section id and element size
+ *  Return param: Section table entry (NULL if absent)
+ *  Description : Finds a section
+ */
+const SnapshotSection *SnapshotReader::find( const uint32_t &i_id,
+                                             const uint32_t &i_elemSize ) const {
+  if( m_data == NULL )
+    return NULL;
+
+  for( uint32_t l_i = 0; l_i < header().m_numSections; ++l_i )
+    if( m_sections[l_i].m_id == i_id && m_sections[l_i].m_elemSize == i_elemSize )
+      return &m_sections[l_i];
+
+  return NULL;
+}
+
+/** Input params: Section id
+ *  Return param: Boolean
+ *  Description : Section present or not
+ */
+bool SnapshotReader::has( const uint32_t &i_id ) const {
+  if( m_data == NULL )
+    return false;
+
+  for( uint32_t l_i = 0; l_i < header().m_numSections; ++l_i )
+    if( m_sections[l_i].m_id == i_id )
+      return true;
+
+  return false;
+}
+
+/** Input params: Section id, element size, count and data (passed by reference)
+ *  Return param: Boolean
+ *  Description : Raw contents of a section
+ */
+bool SnapshotReader::raw( const uint32_t &i_id,
+                                uint32_t &o_elemSize,
+                                uint64_t &o_count,
+                          const void    *&o_data ) const {
+  if( m_data == NULL )
+    return false;
+
+  for( uint32_t l_i = 0; l_i < header().m_numSections; ++l_i ) {
+    if( m_sections[l_i].m_id == i_id ) {
+      o_elemSize = m_sections[l_i].m_elemSize;
+      o_count    = m_sections[l_i].m_count;
+      o_data     = m_data + m_sections[l_i].m_offset;
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of the graph snapshot file format and of classes
+ * SnapshotWriter and SnapshotReader used to save and memory-map it.
+ **/
+
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "MappedArray.hpp"
+
+/** Snapshot layout (native byte order):
+ *    SnapshotHeader
+ *    SnapshotSection[m_numSections]
+ *    section data, each section starting at a multiple of 64 bytes
+ *  A section is a flat array of one of the graph's MappedArrays, so loading
+ *  a snapshot is mapping the file and pointing the arrays into it.
+ */
+
+//! Version of the snapshot format (bump on any layout change)
+const uint32_t SNAPSHOT_VERSION = 2;
+
+//! Sections of a snapshot
+enum SnapshotSectionId {
+  SNAP_ACTOR_CHARS = 1,   //! Actor names
+  SNAP_ACTOR_OFFSETS,
+  SNAP_ACTOR_SORTED,
+  SNAP_MOVIE_CHARS,       //! Movie names (movie#@year)
+  SNAP_MOVIE_OFFSETS,
+  SNAP_MOVIE_YEARS,
+  SNAP_FILM_OFFSETS,      //! Filmography of each actor
+  SNAP_FILM_IDS,
+  SNAP_CAST_OFFSETS,      //! Cast of each movie
+  SNAP_CAST_IDS,
+  SNAP_CSR_OFFSETS,       //! Co-star adjacency with unweighted edges (optional)
+  SNAP_CSR_NEIGHBORS,
+  SNAP_CSR_WEIGHTS,
+  SNAP_CSR_MOVIES,
+  SNAP_LANDMARKS,         //! Landmarks of A* traversal (optional, over the unweighted adjacency)
+  SNAP_LANDMARK_DIST,
+  SNAP_CONNECT_PARENT,    //! Kruskal reconstruction tree of actorconnections (optional)
+  SNAP_CONNECT_YEAR,
+  SNAP_CONNECT_DEPTH,
+  SNAP_CONNECT_HEAD,
+  SNAP_W_CSR_OFFSETS,     //! Co-star adjacency with weighted edges (optional)
+  SNAP_W_CSR_NEIGHBORS,
+  SNAP_W_CSR_WEIGHTS,
+  SNAP_W_CSR_MOVIES,
+  SNAP_W_LANDMARKS,       //! Landmarks of A* traversal (optional, over the weighted adjacency)
+  SNAP_W_LANDMARK_DIST
+};
+
+//! Fixed-size header at the start of a snapshot
+struct SnapshotHeader {
+  char      m_magic[8];     //! "SDKBSNAP"
+  uint32_t  m_version;      //! SNAPSHOT_VERSION
+  uint32_t  m_numSections;  //! Entries in the section table
+  uint64_t  m_sourceSize;   //! Size of the cast file it was built from
+  int64_t   m_sourceMtime;  //! Modification time of that cast file
+  char      m_pad[8];
+};
+
+//! Entry of the section table
+struct SnapshotSection {
+  uint32_t  m_id;           //! SnapshotSectionId
+  uint32_t  m_elemSize;     //! Bytes per element
+  uint64_t  m_offset;       //! Start of the data in the file
+  uint64_t  m_count;        //! Number of elements
+};
+
+//! Section of the co-star adjacency (or its landmarks) of u/w edges, given its unweighted id
+uint32_t adjacencySection( const uint32_t &i_id,
+                           const char     &i_edges );
+
+//! Size and modification time of a file (false if it can't be stat'ed)
+bool sourceStamp( const char *i_file,
+                  uint64_t   &o_size,
+                  int64_t    &o_mtime );
+
+class SnapshotReader;
+
+//! Class collecting arrays and writing them out as a snapshot
+class SnapshotWriter {
+private:
+  std::vector< SnapshotSection >  m_sections; //! Section table
+  std::vector< const void * >     m_data;     //! Data of each section
+
+  //! Add a section of i_count elements of i_elemSize bytes
+  void addRaw( const uint32_t &i_id,
+               const uint32_t &i_elemSize,
+               const uint64_t &i_count,
+               const void     *i_data );
+
+public:
+  SnapshotHeader m_header;  //! Header (source stamp filled by caller)
+
+  //! Constructor
+  SnapshotWriter();
+
+  //! Add an array as a section (it must stay alive until write)
+  template< typename T >
+  void add( const uint32_t       &i_id,
+            const MappedArray< T > &i_arr ) {
+    addRaw( i_id, sizeof( T ), i_arr.size(), i_arr.data() );
+  }
+
+  //! Add a section of a mapped snapshot as it is (nothing if absent; the mapping must stay until write)
+  void carry( const SnapshotReader &i_reader,
+              const uint32_t       &i_id );
+
+  //! Write the snapshot (through a temporary file renamed into place)
+  bool write( const char *i_file );
+};
+
+//! Class mapping a snapshot and handing out views of its sections
+class SnapshotReader {
+private:
+  int                     m_fd;       //! File descriptor
+  const char             *m_data;     //! Mapped file contents
+  size_t                  m_size;     //! Size of the file in bytes
+  const SnapshotSection  *m_sections; //! Section table inside the mapping
+
+  //! Section with a given id and element size (NULL if absent)
+  const SnapshotSection *find( const uint32_t &i_id,
+                               const uint32_t &i_elemSize ) const;
+
+public:
+  //! Constructor
+  SnapshotReader();
+
+  //! Destructor (unmaps the file)
+  ~SnapshotReader();
+
+  //! Map and validate a snapshot, describing any problem in o_error
+  bool open( const char  *i_file,
+             std::string &o_error );
+
+  //! Unmap the snapshot (every view into it becomes invalid)
+  void close();
+
+  //! Header of the mapped snapshot
+  const SnapshotHeader &header() const {
+    return *(const SnapshotHeader *) m_data;
+  }
+
+  //! Section present or not
+  bool has( const uint32_t &i_id ) const;
+
+  //! Element size, count and data of a section (false if absent)
+  bool raw( const uint32_t &i_id,
+                  uint32_t &o_elemSize,
+                  uint64_t &o_count,
+            const void    *&o_data ) const;
+
+  //! Point an array at a section (false if the section is absent)
+  template< typename T >
+  bool view( const uint32_t   &i_id,
+             MappedArray< T > &o_arr ) const {
+    const SnapshotSection *l_sec = find( i_id, sizeof( T ) );
+    if( l_sec == NULL )
+      return false;
+
+    o_arr.view( (const T *) (m_data + l_sec->m_offset), (size_t) l_sec->m_count );
+    return true;
+  }
+};
+
+#endif //! GRAPH_SNAPSHOT_H
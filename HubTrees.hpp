@@ -0,0 +1,133 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct HubTrees, the complete shortest-path trees of a few
+ * hub actors answering every pair with a hub at either end.
+ **/
+
+#ifndef HUB_TREES_HPP
+#define HUB_TREES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/** Shortest-path trees of a few hub actors over all actors. For hub h and
+ *  actor v, entry h * numActors + v holds the distance of v from the hub,
+ *  the previous actor on the path from the hub and the movie linking the
+ *  two, so the path between a hub and any actor is read off the arrays
+ *  without a search or an edge lookup.
+ */
+struct HubTrees {
+  std::vector< int >  m_hubs;       //! Actor-index of each hub
+  std::vector< int >  m_hubOf;      //! Hub number of each actor (-1 if not a hub)
+  std::vector< int >  m_dist;       //! Distance from the hub (max int if unreachable)
+  std::vector< int >  m_prev;       //! Previous actor on the path from the hub
+  std::vector< int >  m_movie;      //! Movie between the previous actor and this one
+  int                 m_numActors;  //! Actors in each tree
+
+  HubTrees() : m_numActors(0) {}
+
+  int numHubs() const {
+    return (int) m_hubs.size();
+  }
+
+  bool empty() const {
+    return m_hubs.empty();
+  }
+
+  //! Bytes held by the arrays
+  size_t bytes() const {
+    return (m_hubs.size() + m_hubOf.size() + m_dist.size() + m_prev.size() + m_movie.size()) * sizeof( int );
+  }
+
+  //! Hub number of an actor (-1 if not a hub)
+  int hubOf( const int &i_actor ) const {
+    return m_hubOf.empty() ? -1 : m_hubOf[i_actor];
+  }
+
+  //! Distance of an actor from a hub
+  int dist( const int &i_hub,
+            const int &i_actor ) const {
+    return m_dist[(size_t) i_hub * m_numActors + i_actor];
+  }
+
+  /** Input params: Hub number, actor, path from the hub or to it, path
+   *                (passed by reference)
+   *  Return param: None
+   *  Description : Path between a hub and an actor as ids (actor, movie,
+   *                actor, ...), empty if they aren't connected
+   */
+  void path( const int                &i_hub,
+             const int                &i_actor,
+             const bool               &i_fromHub,
+                   std::vector< int > &o_path ) const {
+    size_t l_base = (size_t) i_hub * m_numActors;
+
+    o_path.clear();
+    if( m_dist[l_base + i_actor] == std::numeric_limits< int >::max() )
+      return;
+
+    //! Walk the tree from the actor up to the hub
+    o_path.push_back( i_actor );
+    for( int l_curr = i_actor; l_curr != m_hubs[i_hub]; l_curr = m_prev[l_base + l_curr] ) {
+      o_path.push_back( m_movie[l_base + l_curr] );
+      o_path.push_back( m_prev[l_base + l_curr] );
+    }
+
+    if( i_fromHub )
+      std::reverse( o_path.begin(), o_path.end() );
+  }
+
+  /** Input params: Actor pair, path (passed by reference)
+   *  Return param: Boolean stating whether either actor is a hub
+   *  Description : Path of a pair with a hub at either end
+   *
+   *  A hub's tree gives the paths from it, and read backwards the paths to it
+   *  (same cost, as edges aren't directed).
+   */
+  bool find( const int                &i_from,
+             const int                &i_to,
+                   std::vector< int > &o_path ) const {
+    int l_hub = hubOf( i_from );
+    if( l_hub != -1 ) {
+      path( l_hub, i_to, true, o_path );
+      return true;
+    }
+
+    l_hub = hubOf( i_to );
+    if( l_hub != -1 ) {
+      path( l_hub, i_from, false, o_path );
+      return true;
+    }
+
+    return false;
+  }
+};
+
+#endif //! HUB_TREES_HPP
@@ -0,0 +1,85 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct LandmarkTable, the landmark distances giving the
+ * lower bounds of A* traversal (ALT).
+ **/
+
+#ifndef LANDMARK_TABLE_HPP
+#define LANDMARK_TABLE_HPP
+
+#include <cstdlib>
+#include <limits>
+
+#include "MappedArray.hpp"
+
+/** Distances between a few landmark actors and every actor. Edges are
+ *  undirected, so by the triangle inequality |d(L, v) - d(L, t)| <= d(v, t)
+ *  for every landmark L, and the largest of these is a lower bound on the
+ *  remaining cost from v to t. The distances of actor v to all landmarks sit
+ *  next to each other at m_dist[v * numLandmarks() ...].
+ */
+struct LandmarkTable {
+  MappedArray< int >  m_landmarks;  //! Global actor-index of each landmark
+  MappedArray< int >  m_dist;       //! Distance of each actor to each landmark (max int if unreachable)
+
+  int numLandmarks() const {
+    return (int) m_landmarks.size();
+  }
+
+  bool empty() const {
+    return m_landmarks.empty();
+  }
+
+  //! Bytes held by the arrays
+  size_t bytes() const {
+    return (m_landmarks.size() + m_dist.size()) * sizeof( int );
+  }
+
+  //! Lower bound on the distance between 2 actors
+  int bound( const int &i_from,
+             const int &i_to ) const {
+    int        l_bound = 0;
+    int        l_count = numLandmarks();
+    const int *l_from  = m_dist.data() + (size_t) i_from * l_count;
+    const int *l_to    = m_dist.data() + (size_t) i_to * l_count;
+
+    for( int l_l = 0; l_l < l_count; ++l_l ) {
+      //! Landmarks not reaching both actors say nothing
+      if( l_from[l_l] == std::numeric_limits< int >::max() ||
+          l_to[l_l]   == std::numeric_limits< int >::max() )
+        continue;
+
+      if( std::abs( l_from[l_l] - l_to[l_l] ) > l_bound )
+        l_bound = std::abs( l_from[l_l] - l_to[l_l] );
+    }
+
+    return l_bound;
+  }
+};
+
+#endif //! LANDMARK_TABLE_HPP
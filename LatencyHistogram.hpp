@@ -0,0 +1,130 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class LatencyHistogram, a fixed-size log-bucketed histogram
+ * of request latencies.
+ **/
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/** Histogram of latencies in tenths of a microsecond. Values below 2^SUB_BITS
+ *  get a bucket each; above, every power of 2 is split into 2^SUB_BITS
+ *  buckets, so a percentile is off by at most 1/2^(SUB_BITS+1) of its value
+ *  while the memory stays the same however many requests are recorded. The
+ *  count, sum, minimum and maximum are exact.
+ */
+class LatencyHistogram {
+private:
+  //! Bits of a value kept below its leading one (buckets per power of 2: 16)
+  static const int SUB_BITS = 4;
+
+  //! Buckets of 64-bit values
+  static const int NUM_BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS;
+
+  std::vector< long long > m_buckets;  //! Values recorded in each bucket
+  long long                m_count;    //! Values recorded
+  double                   m_sum;      //! Their sum (microseconds)
+  double                   m_min;      //! Least value (microseconds)
+  double                   m_max;      //! Greatest value (microseconds)
+
+  //! Bucket of a value (tenths of a microsecond)
+  static int bucketOf( const uint64_t &i_ticks ) {
+    if( i_ticks < (1ULL << SUB_BITS) )
+      return (int) i_ticks;
+
+    int l_exp = 63 - __builtin_clzll( i_ticks );    //! Position of the leading one
+    return ((l_exp - SUB_BITS + 1) << SUB_BITS) + (int) ((i_ticks >> (l_exp - SUB_BITS)) & ((1ULL << SUB_BITS) - 1));
+  }
+
+  //! Middle of a bucket's range (microseconds)
+  static double middleOf( const int &i_bucket ) {
+    if( i_bucket < (1 << SUB_BITS) )
+      return i_bucket / 10.0;
+
+    int    l_exp   = (i_bucket >> SUB_BITS) + SUB_BITS - 1;
+    double l_width = (double) (1ULL << (l_exp - SUB_BITS));
+    double l_low   = (double) (1ULL << l_exp) + (i_bucket & ((1 << SUB_BITS) - 1)) * l_width;
+
+    return (l_low + l_width / 2) / 10.0;
+  }
+
+public:
+  LatencyHistogram() : m_buckets( NUM_BUCKETS, 0 ), m_count(0), m_sum(0), m_min(0), m_max(0) {}
+
+  //! Record a latency (microseconds)
+  void add( const double &i_us ) {
+    double l_us = std::max( i_us, 0.0 );
+
+    ++m_buckets[bucketOf( (uint64_t) std::min( l_us * 10, 1.8e19 ) )];
+    m_min  = (m_count == 0) ? l_us : std::min( m_min, l_us );
+    m_max  = std::max( m_max, l_us );
+    m_sum += l_us;
+    ++m_count;
+  }
+
+  long long count() const {
+    return m_count;
+  }
+
+  double mean() const {
+    return (m_count == 0) ? 0 : m_sum / m_count;
+  }
+
+  double max() const {
+    return m_max;
+  }
+
+  /** Input params: Fraction of the values at or below the result (0 to 1)
+   *  Return param: Latency (microseconds)
+   *  Description : Estimates a percentile
+   *
+   *  Returns the middle of the bucket holding the value of rank
+   *  i_fraction * count, kept within the exact minimum and maximum.
+   */
+  double percentile( const double &i_fraction ) const {
+    if( m_count == 0 )
+      return 0;
+
+    long long l_rank = std::min( (long long) (i_fraction * m_count), m_count - 1 );
+    long long l_seen = 0;
+
+    for( int l_b = 0; l_b < NUM_BUCKETS; ++l_b ) {
+      l_seen += m_buckets[l_b];
+      if( l_seen > l_rank )
+        return std::min( std::max( middleOf( l_b ), m_min ), m_max );
+    }
+
+    return m_max;
+  }
+};
+
+#endif //! LATENCY_HISTOGRAM_HPP
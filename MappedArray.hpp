@@ -0,0 +1,178 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration and implementation of class template MappedArray, an array
+ * that either owns its elements or views a read-only range of a mapped file.
+ **/
+
+#ifndef MAPPED_ARRAY_HPP
+#define MAPPED_ARRAY_HPP
+
+#include <cstddef>
+#include <vector>
+
+/** Array used for the graph's flat arrays. It is filled with push_back while
+ *  the graph is built from a cast file, or made to view a section of a mapped
+ *  snapshot so that loading costs no per-element work. Reads go through
+ *  the const operator[] in both cases; writing to a viewed array first copies
+ *  it into owned storage.
+ */
+template< typename T >
+class MappedArray {
+private:
+  std::vector< T >  m_own;    //! Owned elements (unused when viewing)
+  const T          *m_data;   //! First element
+  size_t            m_size;   //! Number of elements
+  bool              m_mapped; //! Viewing memory owned by someone else or not
+
+  //! Copy viewed elements into owned storage before a write
+  void detach() {
+    if( m_mapped ) {
+      m_own.assign( m_data, m_data + m_size );
+      m_mapped = false;
+    }
+  }
+
+  //! Point at owned storage after it may have moved
+  void sync() {
+    m_data = m_own.empty() ? NULL : &m_own[0];
+    m_size = m_own.size();
+  }
+
+public:
+  //! Constructor
+  MappedArray() : m_data(NULL), m_size(0), m_mapped(false) {}
+
+  //! Copy constructor
+  MappedArray( const MappedArray &i_other ) : m_data(NULL), m_size(0), m_mapped(false) {
+    *this = i_other;
+  }
+
+  //! Copy assignment (a view stays a view of the same memory)
+  MappedArray &operator = ( const MappedArray &i_other ) {
+    m_own    = i_other.m_own;
+    m_mapped = i_other.m_mapped;
+
+    if( m_mapped ) {
+      m_data = i_other.m_data;
+      m_size = i_other.m_size;
+    } else
+      sync();
+
+    return *this;
+  }
+
+  //! View i_size elements at i_data (which must outlive the array)
+  void view( const T      *i_data,
+             const size_t &i_size ) {
+    std::vector< T >().swap( m_own );
+    m_data   = i_data;
+    m_size   = i_size;
+    m_mapped = true;
+  }
+
+  //! Append an element
+  void push_back( const T &i_val ) {
+    detach();
+    m_own.push_back( i_val );
+    sync();
+  }
+
+  //! Append i_count elements starting at i_first
+  void append( const T      *i_first,
+               const size_t &i_count ) {
+    detach();
+    m_own.insert( m_own.end(), i_first, i_first + i_count );
+    sync();
+  }
+
+  //! Take over the elements of a vector (left empty) instead of the current ones
+  void adopt( std::vector< T > &io_elements ) {
+    std::vector< T >().swap( m_own );
+    m_own.swap( io_elements );
+    m_mapped = false;
+    sync();
+  }
+
+  //! Overwrite the element at i_pos
+  void set( const size_t &i_pos,
+            const T      &i_val ) {
+    detach();
+    m_own[i_pos] = i_val;
+  }
+
+  //! Reserve owned storage
+  void reserve( const size_t &i_size ) {
+    detach();
+    m_own.reserve( i_size );
+    sync();
+  }
+
+  //! Remove all elements
+  void clear() {
+    std::vector< T >().swap( m_own );
+    m_mapped = false;
+    sync();
+  }
+
+  //! Element at i_pos
+  const T &operator [] ( const size_t &i_pos ) const {
+    return m_data[i_pos];
+  }
+
+  //! First element
+  const T *data() const {
+    return m_data;
+  }
+
+  //! Past-the-end element
+  const T *end() const {
+    return m_data + m_size;
+  }
+
+  //! Number of elements
+  size_t size() const {
+    return m_size;
+  }
+
+  //! No elements or not
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  //! Viewing a mapping or not
+  bool isMapped() const {
+    return m_mapped;
+  }
+
+  //! Bytes of heap memory held (a view holds none)
+  size_t bytes() const {
+    return m_own.capacity() * sizeof( T );
+  }
+};
+
+#endif //! MAPPED_ARRAY_HPP
@@ -0,0 +1,77 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct MovieTable, the interned movies of the cast file.
+ **/
+
+#ifndef MOVIE_TABLE_HPP
+#define MOVIE_TABLE_HPP
+
+#include <string>
+#include <unordered_map>
+
+#include "MappedArray.hpp"
+#include "NameTable.hpp"
+
+/** Movies interned at load time. Every distinct movie#@year gets a dense id;
+ *  the name and year of a movie are then array reads at that id.
+ */
+struct MovieTable {
+  NameTable                               m_names;      //! Movie of each id (movie#@year)
+  MappedArray< int >                      m_years;      //! Year of each id
+  std::unordered_map< std::string, int >  m_idOfMovie;  //! Id of each movie#@year (while loading)
+
+  //! Number of movies
+  int size() const {
+    return (int) m_years.size();
+  }
+
+  /** Input params: Movie (of form movie#@year) and its year
+   *  Return param: Id of the movie
+   *  Description : Looks up a movie, assigning it the next id if unseen
+   */
+  int intern( const std::string &i_movie,
+              const int         &i_year ) {
+    std::unordered_map< std::string, int >::iterator l_it = m_idOfMovie.find( i_movie );
+    if( l_it != m_idOfMovie.end() )
+      return l_it->second;
+
+    int l_id = size();
+    m_idOfMovie[i_movie] = l_id;
+    m_names.append( i_movie.data(), (int) i_movie.size() );
+    m_years.push_back( i_year );
+
+    return l_id;
+  }
+
+  //! Drop the lookup map once all movies are interned
+  void finishInterning() {
+    std::unordered_map< std::string, int >().swap( m_idOfMovie );
+  }
+};
+
+#endif //! MOVIE_TABLE_HPP
@@ -0,0 +1,145 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct NameTable, a pooled string table of actor or movie
+ * names addressed by index.
+ **/
+
+#ifndef NAME_TABLE_HPP
+#define NAME_TABLE_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "MappedArray.hpp"
+
+/** Names stored back to back in one character array. Name i occupies
+ *  m_chars[m_offsets[i] .. m_offsets[i + 1]). m_sorted lists the indices in
+ *  lexicographic order of the names so that a name is found by binary search
+ *  without any hash-map.
+ */
+struct NameTable {
+  MappedArray< char > m_chars;    //! Characters of all names
+  MappedArray< int >  m_offsets;  //! Start of each name (size: names + 1)
+  MappedArray< int >  m_sorted;   //! Name indices sorted by name
+
+  //! Comparator ordering name indices by their names
+  struct Less {
+    const NameTable *m_table;
+
+    bool operator () ( const int &i_lhs, const int &i_rhs ) const {
+      return m_table->compare( i_lhs, m_table->data( i_rhs ), m_table->length( i_rhs ) ) < 0;
+    }
+  };
+
+  //! Number of names
+  int size() const {
+    return m_offsets.empty() ? 0 : (int) m_offsets.size() - 1;
+  }
+
+  //! First character of name i (not null-terminated)
+  const char *data( const int &i_index ) const {
+    return m_chars.data() + m_offsets[i_index];
+  }
+
+  //! Length of name i
+  int length( const int &i_index ) const {
+    return m_offsets[i_index + 1] - m_offsets[i_index];
+  }
+
+  //! Copy of name i
+  std::string name( const int &i_index ) const {
+    return std::string( data( i_index ), length( i_index ) );
+  }
+
+  //! Append a name, which gets the next index
+  void append( const char *i_name,
+               const int  &i_len ) {
+    if( m_offsets.empty() )
+      m_offsets.push_back( 0 );
+
+    m_chars.append( i_name, i_len );
+
+    m_offsets.push_back( (int) m_chars.size() );
+  }
+
+  //! Three-way comparison of name i against a string
+  int compare( const int  &i_index,
+               const char *i_name,
+               const int  &i_len ) const {
+    int l_len = length( i_index );
+    int l_cmp = std::memcmp( data( i_index ), i_name, std::min( l_len, i_len ) );
+
+    if( l_cmp != 0 )
+      return l_cmp;
+
+    return (l_len < i_len) ? -1 : (l_len > i_len ? 1 : 0);
+  }
+
+  //! Build the sorted index (after the last append)
+  void sortIndex() {
+    std::vector< int > l_order( size() );
+    for( int l_i = 0; l_i < size(); ++l_i )
+      l_order[l_i] = l_i;
+
+    Less l_less = { this };
+    std::sort( l_order.begin(), l_order.end(), l_less );
+
+    m_sorted.clear();
+    m_sorted.reserve( l_order.size() );
+    for( size_t l_i = 0; l_i < l_order.size(); ++l_i )
+      m_sorted.push_back( l_order[l_i] );
+  }
+
+  //! Index of a name (-1 if not present), using the sorted index
+  int find( const std::string &i_name ) const {
+    int l_lo = 0, l_hi = (int) m_sorted.size();
+
+    while( l_lo < l_hi ) {
+      int l_mid = l_lo + (l_hi - l_lo) / 2;
+
+      if( compare( m_sorted[l_mid], i_name.data(), (int) i_name.size() ) < 0 )
+        l_lo = l_mid + 1;
+      else
+        l_hi = l_mid;
+    }
+
+    if( l_lo < (int) m_sorted.size() &&
+        compare( m_sorted[l_lo], i_name.data(), (int) i_name.size() ) == 0 )
+      return m_sorted[l_lo];
+
+    return -1;
+  }
+
+  //! Bytes of heap memory held
+  size_t bytes() const {
+    return m_chars.bytes() + m_offsets.bytes() + m_sorted.bytes();
+  }
+};
+
+#endif //! NAME_TABLE_HPP
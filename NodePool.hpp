@@ -0,0 +1,104 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class NodePool, bulk storage of the graph's nodes and edges.
+ **/
+
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/** Objects of one type, handed out from blocks of BLOCK of them by
+ *  bumping a cursor. Nothing is freed on its own: clear() destroys all
+ *  objects at once (O(1) for trivially destructible types such as Edge) and
+ *  keeps the blocks, so refilling the pool allocates nothing.
+ */
+template< class T >
+class NodePool {
+  static const size_t BLOCK = 1 << 12;  //! Objects per block
+
+  std::vector< T * >  m_blocks;  //! Storage of BLOCK objects each
+  size_t              m_block;   //! Block being filled
+  size_t              m_slot;    //! Next free slot of that block
+
+  NodePool( const NodePool & );
+  NodePool &operator=( const NodePool & );
+
+public:
+  NodePool() : m_block(0), m_slot(0) {}
+
+  ~NodePool() {
+    clear();
+    for( size_t l_b = 0; l_b < m_blocks.size(); ++l_b )
+      ::operator delete( m_blocks[l_b] );
+  }
+
+  /** Input params: None
+   *  Return param: New (value-initialized) object
+   *  Description : Creates an object in the next free slot
+   */
+  T *create() {
+    if( m_slot == BLOCK ) {
+      ++m_block;
+      m_slot = 0;
+    }
+
+    if( m_block == m_blocks.size() )
+      m_blocks.push_back( static_cast< T * >( ::operator new( sizeof( T ) * BLOCK ) ) );
+
+    return new( m_blocks[m_block] + m_slot++ ) T();
+  }
+
+  //! Destroy all objects (the blocks are kept for reuse)
+  void clear() {
+    if( !std::is_trivially_destructible< T >::value )
+      for( size_t l_b = 0; l_b < m_blocks.size() && l_b <= m_block; ++l_b )
+        for( size_t l_s = 0; l_s < (l_b == m_block ? m_slot : BLOCK); ++l_s )
+          m_blocks[l_b][l_s].~T();
+
+    m_block = 0;
+    m_slot  = 0;
+  }
+
+  //! Number of objects
+  size_t size() const {
+    return m_block * BLOCK + m_slot;
+  }
+
+  //! Bytes of the blocks allocated so far
+  size_t bytes() const {
+    return m_blocks.size() * BLOCK * sizeof( T );
+  }
+};
+
+template< class T >
+const size_t NodePool< T >::BLOCK;
+
+#endif //! NODE_POOL_HPP
@@ -0,0 +1,102 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of class OutputWriter's member functions required to
+ * stream output lines to a file.
+ **/
+
+#include "OutputWriter.h"
+
+/** Input params: Buffer size that triggers a write
+ *  Return param: None
+ *  Description : Constructor
+ */
+OutputWriter::OutputWriter( const size_t &i_flushSize ) : m_flushSize(i_flushSize),
+                                                          m_numLines(0),
+                                                          m_numBytes(0) {}
+
+/** Input params: Output filename
+ *  Return param: Boolean
+ *  Description : Opens the output file
+ */
+bool OutputWriter::open( const char *i_file ) {
+  m_out.open( i_file, std::ios::binary | std::ios::trunc );
+  m_buffer.reserve( m_flushSize + 4096 );
+
+  return m_out.is_open();
+}
+
+/** Input params: Line and its length
+ *  Return param: None
+ *  Description : Buffers a line
+ *
+ *  Appends the line and a newline to the buffer and writes the buffer out
+ *  once it holds m_flushSize bytes, so memory stays bounded however many
+ *  lines are written.
+ */
+void OutputWriter::writeLine( const char   *i_line,
+                              const size_t &i_len ) {
+  m_buffer.append( i_line, i_len );
+  m_buffer.push_back( '\n' );
+
+  ++m_numLines;
+  m_numBytes += (long long) i_len + 1;
+
+  if( m_buffer.size() >= m_flushSize )
+    flush();
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Writes out the buffer
+ *
+ *  Hands it to the file as well (not only the stream's buffer), so the
+ *  lines are in the file once this returns.
+ */
+bool OutputWriter::flush() {
+  if( !m_buffer.empty() ) {
+    m_out.write( m_buffer.data(), m_buffer.size() );
+    m_out.flush();
+    m_buffer.clear();
+  }
+
+  return (bool) m_out;
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Closes the output file
+ */
+bool OutputWriter::close() {
+  if( !m_out.is_open() )
+    return true;
+
+  flush();
+  m_out.close();
+
+  return (bool) m_out;
+}
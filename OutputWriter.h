@@ -0,0 +1,80 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class OutputWriter, a buffered writer streaming output lines
+ * to a file as they are produced.
+ **/
+
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+//! Class collecting output lines in a buffer and writing it out whenever it fills up
+class OutputWriter {
+private:
+  std::ofstream m_out;        //! Output file
+  std::string   m_buffer;     //! Lines not written yet
+  size_t        m_flushSize;  //! Buffer size that triggers a write
+  long long     m_numLines;   //! Lines written (or buffered)
+  long long     m_numBytes;   //! Bytes written (or buffered)
+
+public:
+  //! Constructor
+  OutputWriter( const size_t &i_flushSize = 1 << 20 );
+
+  //! Open (truncate) the output file
+  bool open( const char *i_file );
+
+  //! Buffer a line (the newline is added)
+  void writeLine( const char   *i_line,
+                  const size_t &i_len );
+
+  void writeLine( const std::string &i_line ) {
+    writeLine( i_line.data(), i_line.size() );
+  }
+
+  //! Write out the buffer (to the file, not just the stream)
+  bool flush();
+
+  //! Flush and close the file (false if anything failed to be written)
+  bool close();
+
+  //! Lines so far
+  long long numLines() const {
+    return m_numLines;
+  }
+
+  //! Bytes so far
+  long long numBytes() const {
+    return m_numBytes;
+  }
+};
+
+#endif //! OUTPUT_WRITER_H
@@ -0,0 +1,198 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class PathCache, the least recently used paths found by
+ * pathfinder, kept to answer repeated pairs without a search.
+ **/
+
+#ifndef PATH_CACHE_HPP
+#define PATH_CACHE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Paths of recent queries, keyed by source, target and search mode (an id
+ *  handed out by mode() for each distinct mode name). A path is stored as its
+ *  ids: actor, movie, actor, ..., actor (empty if the actors aren't
+ *  connected). Beyond the capacity, the path used longest ago is dropped.
+ *  When symmetric (edges are undirected, so a shortest path read backwards is
+ *  a shortest path of the reverse pair), a pair and its reverse share one
+ *  entry, stored from the lower actor-index and read backwards for the other.
+ */
+class PathCache {
+private:
+  //! Cache key
+  struct Key {
+    int m_from;   //! Source actor
+    int m_to;     //! Target actor
+    int m_mode;   //! Search mode id
+
+    bool operator == ( const Key &i_other ) const {
+      return m_from == i_other.m_from && m_to == i_other.m_to && m_mode == i_other.m_mode;
+    }
+  };
+
+  //! Hash of a key
+  struct KeyHash {
+    size_t operator () ( const Key &i_key ) const {
+      return std::hash< long long >()( ((long long) i_key.m_from << 32) ^ (unsigned) i_key.m_to ) ^
+             ((size_t) i_key.m_mode * 0x9e3779b97f4a7c15ULL);
+    }
+  };
+
+  typedef std::list< std::pair< Key, std::vector< int > > > Entries;
+
+  size_t                                                m_capacity;   //! Most paths kept (0: no caching)
+  bool                                                  m_symmetric;  //! Pair and reverse share an entry
+  Entries                                               m_entries;    //! Paths, most recently used first
+  std::unordered_map< Key, Entries::iterator, KeyHash > m_index;      //! Entry of each key
+  std::vector< std::string >                            m_modes;      //! Name of each mode id
+  long long                                             m_hits;       //! Lookups answered
+  long long                                             m_misses;     //! Lookups not answered
+
+  //! Key of a pair (false if it is stored reversed)
+  bool key( const int &i_from,
+            const int &i_to,
+            const int &i_mode,
+                  Key &o_key ) const {
+    bool l_forward = !m_symmetric || i_from <= i_to;
+
+    o_key.m_from = l_forward ? i_from : i_to;
+    o_key.m_to   = l_forward ? i_to : i_from;
+    o_key.m_mode = i_mode;
+
+    return l_forward;
+  }
+
+public:
+  //! Constructor (no caching until init)
+  PathCache() : m_capacity(0), m_symmetric(false), m_hits(0), m_misses(0) {}
+
+  //! Set the capacity (in paths) and whether pairs are symmetric, dropping every path
+  void init( const size_t &i_capacity,
+             const bool   &i_symmetric ) {
+    m_capacity  = i_capacity;
+    m_symmetric = i_symmetric;
+    m_entries.clear();
+    m_index.clear();
+  }
+
+  bool enabled() const {
+    return m_capacity > 0;
+  }
+
+  //! Id of a mode name
+  int mode( const std::string &i_name ) {
+    std::vector< std::string >::iterator l_it = std::find( m_modes.begin(), m_modes.end(), i_name );
+    if( l_it != m_modes.end() )
+      return (int) (l_it - m_modes.begin());
+
+    m_modes.push_back( i_name );
+    return (int) m_modes.size() - 1;
+  }
+
+  /** Input params: Source and target actors, mode id, path (passed by
+   *                reference)
+   *  Return param: Boolean (false on a miss)
+   *  Description : Looks up a pair, copying its path from source to target
+   */
+  bool find( const int                &i_from,
+             const int                &i_to,
+             const int                &i_mode,
+                   std::vector< int > &o_path ) {
+    Key  l_key;
+    bool l_forward = key( i_from, i_to, i_mode, l_key );
+
+    std::unordered_map< Key, Entries::iterator, KeyHash >::iterator l_it = m_index.find( l_key );
+    if( l_it == m_index.end() ) {
+      ++m_misses;
+      return false;
+    }
+
+    //! Most recently used now
+    m_entries.splice( m_entries.begin(), m_entries, l_it->second );
+
+    const std::vector< int > &l_path = l_it->second->second;
+    if( l_forward )
+      o_path.assign( l_path.begin(), l_path.end() );
+    else
+      o_path.assign( l_path.rbegin(), l_path.rend() );
+
+    ++m_hits;
+    return true;
+  }
+
+  /** Input params: Source and target actors, mode id, path
+   *  Return param: None
+   *  Description : Stores the path of a pair, dropping the least recently
+   *                used one if full
+   */
+  void insert( const int                &i_from,
+               const int                &i_to,
+               const int                &i_mode,
+               const std::vector< int > &i_path ) {
+    if( !enabled() )
+      return;
+
+    Key  l_key;
+    bool l_forward = key( i_from, i_to, i_mode, l_key );
+
+    std::unordered_map< Key, Entries::iterator, KeyHash >::iterator l_it = m_index.find( l_key );
+    if( l_it != m_index.end() ) {
+      m_entries.splice( m_entries.begin(), m_entries, l_it->second );
+      return;
+    }
+
+    if( m_entries.size() >= m_capacity ) {
+      m_index.erase( m_entries.back().first );
+      m_entries.pop_back();
+    }
+
+    m_entries.push_front( std::make_pair( l_key, l_forward ? i_path
+                                                           : std::vector< int >( i_path.rbegin(), i_path.rend() ) ) );
+    m_index[l_key] = m_entries.begin();
+  }
+
+  //! Paths held
+  size_t size() const {
+    return m_entries.size();
+  }
+
+  long long hits() const {
+    return m_hits;
+  }
+
+  long long misses() const {
+    return m_misses;
+  }
+};
+
+#endif //! PATH_CACHE_HPP
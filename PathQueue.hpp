@@ -0,0 +1,132 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of the priority queues used by Djikstra's traversal.
+ **/
+
+#ifndef PATH_QUEUE_HPP
+#define PATH_QUEUE_HPP
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+/** Binary heap of (distance, actor-index) pairs. Entries carry the distance
+ *  they were pushed with, so an actor whose distance improves is pushed again
+ *  and its stale entries are skipped by the traversal.
+ */
+class HeapQueue {
+protected:
+  std::priority_queue< std::pair< int, int >,
+                       std::vector< std::pair< int, int > >,
+                       std::greater< std::pair< int, int > > > m_heap;
+
+public:
+  bool empty() const {
+    return m_heap.empty();
+  }
+
+  void push( const int &i_node,
+             const int &i_dist ) {
+    m_heap.push( std::make_pair( i_dist, i_node ) );
+  }
+
+  //! Remove an entry of least distance
+  void pop( int &o_node,
+            int &o_dist ) {
+    o_dist = m_heap.top().first;
+    o_node = m_heap.top().second;
+    m_heap.pop();
+  }
+
+  void clear() {
+    m_heap = std::priority_queue< std::pair< int, int >,
+                                  std::vector< std::pair< int, int > >,
+                                  std::greater< std::pair< int, int > > >();
+  }
+};
+
+/** Dial's bucket queue for integer edge-weights in [0, max weight]. While
+ *  settling distance d, every entry in the queue lies in [d, d + max weight],
+ *  so max weight + 1 buckets indexed by distance modulo their count hold one
+ *  distance each. Push is O(1) and pop only steps over empty buckets.
+ */
+class BucketQueue {
+protected:
+  std::vector< std::vector< int > > m_buckets;  //! Actors by distance (modulo bucket count)
+  int                               m_cur;      //! Distance being settled
+  size_t                            m_size;     //! Entries in all buckets
+
+public:
+  BucketQueue() : m_cur(0), m_size(0) {}
+
+  //! Size the queue for a maximum edge-weight (empties it)
+  void init( const int &i_maxWeight ) {
+    m_buckets.assign( i_maxWeight + 1, std::vector< int >() );
+    m_cur  = 0;
+    m_size = 0;
+  }
+
+  //! Number of buckets (max weight + 1)
+  int numBuckets() const {
+    return (int) m_buckets.size();
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  void push( const int &i_node,
+             const int &i_dist ) {
+    m_buckets[i_dist % m_buckets.size()].push_back( i_node );
+    ++m_size;
+  }
+
+  //! Remove an entry of least distance
+  void pop( int &o_node,
+            int &o_dist ) {
+    while( m_buckets[m_cur % m_buckets.size()].empty() )
+      ++m_cur;
+
+    std::vector< int > &l_bucket = m_buckets[m_cur % m_buckets.size()];
+    o_node = l_bucket.back();
+    o_dist = m_cur;
+    l_bucket.pop_back();
+    --m_size;
+  }
+
+  //! Empty the buckets, keeping their storage for the next query
+  void clear() {
+    for( std::vector< int > &l_bucket : m_buckets )
+      l_bucket.clear();
+
+    m_cur  = 0;
+    m_size = 0;
+  }
+};
+
+#endif //! PATH_QUEUE_HPP
@@ -0,0 +1,230 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct QueryStats, the counters of a query's traversal, and
+ * class MetricsLog, writing them as JSON lines along with a run summary.
+ **/
+
+#ifndef QUERY_METRICS_HPP
+#define QUERY_METRICS_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OutputWriter.h"
+
+//! Work done by a query (or by all of them)
+struct QueryStats {
+  long long m_popped;     //! Actors taken off the queue (or frontier)
+  long long m_scanned;    //! Edges (co-stars or cast entries) looked at
+  long long m_pushes;     //! Actors put on the queue
+  long long m_stalePops;  //! Queue entries of actors settled already (Djikstra's)
+  long long m_unions;     //! Disjoint set unions (union-find)
+  long long m_finds;      //! Disjoint set finds (union-find)
+  long long m_targets;    //! Pairs served by the search (pathfinder shares a search per source)
+  double    m_micros;     //! Time taken
+
+  QueryStats() {
+    clear();
+  }
+
+  void clear() {
+    m_popped = m_scanned = m_pushes = m_stalePops = m_unions = m_finds = m_targets = 0;
+    m_micros = 0;
+  }
+
+  QueryStats &operator+=( const QueryStats &i_other ) {
+    m_popped    += i_other.m_popped;
+    m_scanned   += i_other.m_scanned;
+    m_pushes    += i_other.m_pushes;
+    m_stalePops += i_other.m_stalePops;
+    m_unions    += i_other.m_unions;
+    m_finds     += i_other.m_finds;
+    m_targets   += i_other.m_targets;
+    m_micros    += i_other.m_micros;
+    return *this;
+  }
+
+  //! Work done since an earlier copy of the counters (time and targets left out)
+  QueryStats since( const QueryStats &i_before ) const {
+    QueryStats l_diff;
+
+    l_diff.m_popped    = m_popped    - i_before.m_popped;
+    l_diff.m_scanned   = m_scanned   - i_before.m_scanned;
+    l_diff.m_pushes    = m_pushes    - i_before.m_pushes;
+    l_diff.m_stalePops = m_stalePops - i_before.m_stalePops;
+    l_diff.m_unions    = m_unions    - i_before.m_unions;
+    l_diff.m_finds     = m_finds     - i_before.m_finds;
+    return l_diff;
+  }
+
+  //! Append the counters as JSON members (no braces)
+  void appendJson( std::string &io_line ) const {
+    char l_buf[256];
+
+    std::snprintf( l_buf, sizeof( l_buf ),
+                   "\"popped\":%lld,\"scanned\":%lld,\"pushes\":%lld,\"stale_pops\":%lld,"
+                   "\"unions\":%lld,\"finds\":%lld,\"targets\":%lld,\"us\":%.1f",
+                   m_popped, m_scanned, m_pushes, m_stalePops, m_unions, m_finds, m_targets, m_micros );
+    io_line += l_buf;
+  }
+};
+
+/** JSON-lines metrics of a run: a line per query, written as the queries are
+ *  answered, then a summary line with the totals and the wall time of each
+ *  phase (load, build, query, write). Phases are timed whether or not a file
+ *  is open, so the summary can be printed either way.
+ */
+class MetricsLog {
+private:
+  OutputWriter  m_out;          //! JSON lines
+  bool          m_enabled;      //! A file is open
+  long long     m_numQueries;   //! Query lines written
+  QueryStats    m_total;        //! Sum of the queries' counters
+
+  //! Seconds spent in each phase, in the order first seen
+  std::vector< std::pair< std::string, double > > m_phases;
+
+public:
+  MetricsLog() : m_enabled(false), m_numQueries(0) {}
+
+  //! Open (truncate) the metrics file
+  bool open( const char *i_file ) {
+    m_enabled = m_out.open( i_file );
+    return m_enabled;
+  }
+
+  //! Whether query lines are wanted
+  bool enabled() const {
+    return m_enabled;
+  }
+
+  //! Add the time since io_start to a phase and restart io_start
+  void endPhase( const std::string                                    &i_phase,
+                       std::chrono::high_resolution_clock::time_point &io_start ) {
+    std::chrono::high_resolution_clock::time_point l_now = std::chrono::high_resolution_clock::now();
+    addPhase( i_phase, std::chrono::duration< double >( l_now - io_start ).count() );
+    io_start = l_now;
+  }
+
+  //! Add seconds to a phase
+  void addPhase( const std::string &i_phase,
+                 const double      &i_secs ) {
+    for( std::pair< std::string, double > &l_phase : m_phases ) {
+      if( l_phase.first == i_phase ) {
+        l_phase.second += i_secs;
+        return;
+      }
+    }
+
+    m_phases.push_back( std::make_pair( i_phase, i_secs ) );
+  }
+
+  //! Add work done for several queries at once (e.g. a sweep) to the totals
+  void addWork( const QueryStats &i_stats ) {
+    m_total += i_stats;
+  }
+
+  /** Input params: JSON members describing the query (no braces), counters,
+   *                add them to the totals or not (shared work added by addWork)
+   *  Return param: None
+   *  Description : Writes a query line
+   */
+  void query( const std::string &i_members,
+              const QueryStats  &i_stats,
+              const bool        &i_addToTotal = true ) {
+    if( i_addToTotal )
+      m_total += i_stats;
+    ++m_numQueries;
+
+    if( !m_enabled )
+      return;
+
+    std::string l_line = "{" + i_members + ",";
+    i_stats.appendJson( l_line );
+    l_line += "}";
+    m_out.writeLine( l_line );
+  }
+
+  //! Write out the query lines so far (a server's lines reach the file as they are answered)
+  bool flush() {
+    return !m_enabled || m_out.flush();
+  }
+
+  /** Input params: None
+   *  Return param: Boolean
+   *  Description : Prints the phases and writes the summary line
+   */
+  bool close() {
+    std::string l_line = "{\"summary\":true,\"queries\":" + std::to_string( m_numQueries ) + ",";
+    char l_buf[64];
+
+    m_total.appendJson( l_line );
+    l_line += ",\"phases\":{";
+
+    std::cout << "Phases:";
+    for( size_t l_p = 0; l_p < m_phases.size(); ++l_p ) {
+      std::snprintf( l_buf, sizeof( l_buf ), "%s\"%s\":%.6f", l_p > 0 ? "," : "",
+                     m_phases[l_p].first.c_str(), m_phases[l_p].second );
+      l_line += l_buf;
+      std::cout << " " << m_phases[l_p].first << " " << m_phases[l_p].second << "s";
+    }
+    l_line += "}}";
+    std::cout << "\n";
+
+    if( !m_enabled )
+      return true;
+
+    m_out.writeLine( l_line );
+    m_enabled = false;
+    return m_out.close();
+  }
+
+  //! Append a string as a JSON string (quoted and escaped)
+  static void appendString( const std::string &i_str,
+                                  std::string &io_line ) {
+    io_line += '"';
+    for( char l_c : i_str ) {
+      if( l_c == '"' || l_c == '\\' ) {
+        io_line += '\\';
+        io_line += l_c;
+      } else if( (unsigned char) l_c < 0x20 ) {
+        char l_buf[8];
+        std::snprintf( l_buf, sizeof( l_buf ), "\\u%04x", (unsigned char) l_c );
+        io_line += l_buf;
+      } else
+        io_line += l_c;
+    }
+    io_line += '"';
+  }
+};
+
+#endif //! QUERY_METRICS_HPP
@@ -0,0 +1,320 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of class QueryServer's member functions required to
+ * serve actor pairs over stdin or a Unix domain socket.
+ **/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "QueryServer.h"
+
+//! Bytes read from a connection at a time
+static const size_t g_readSize = 1 << 16;
+
+//! SIGTERM or SIGINT received (the server quits like on "quit")
+static volatile sig_atomic_t g_stopSignal = 0;
+
+/** Input params: Signal number
+ *  Return param: None
+ *  Description : Asks the server to stop
+ */
+static void onStopSignal( int ) {
+  g_stopSignal = 1;
+}
+
+/** Input params: File descriptor, data and its length
+ *  Return param: Boolean
+ *  Description : Writes all of the data (false if the peer went away)
+ */
+static bool writeAll( const int    &i_fd,
+                      const char   *i_data,
+                            size_t  i_len ) {
+  while( i_len > 0 ) {
+    ssize_t l_n = write( i_fd, i_data, i_len );
+    if( l_n < 0 && errno == EINTR )
+      continue;
+    if( l_n <= 0 )
+      return false;
+
+    i_data += l_n;
+    i_len  -= (size_t) l_n;
+  }
+
+  return true;
+}
+
+/** Input params: Socket path ("-" for stdin and stdout)
+ *  Return param: None
+ *  Description : Constructor
+ */
+QueryServer::QueryServer( const std::string &i_endpoint ) : m_endpoint(i_endpoint),
+                                                             m_listenFd(-1),
+                                                             m_quit(false) {}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Destructor
+ */
+QueryServer::~QueryServer() {
+  if( m_listenFd != -1 ) {
+    close( m_listenFd );
+    unlink( m_endpoint.c_str() );
+  }
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Starts listening
+ *
+ *  Binds the socket, replacing a stale socket at the path but refusing any
+ *  other kind of file there. With stdin, stdout
+ *  carries the replies only, so std::cout is pointed at stderr: call this
+ *  before loading so that every message of the run goes there. SIGTERM and
+ *  SIGINT interrupt the blocking reads (no SA_RESTART) and stop the server
+ *  like "quit", so the latencies and metrics are still written.
+ */
+bool QueryServer::open() {
+  //! A client going away mid-reply shouldn't end the server
+  signal( SIGPIPE, SIG_IGN );
+
+  struct sigaction l_action;
+  std::memset( &l_action, 0, sizeof( l_action ) );
+  l_action.sa_handler = onStopSignal;
+  sigemptyset( &l_action.sa_mask );
+  sigaction( SIGTERM, &l_action, NULL );
+  sigaction( SIGINT,  &l_action, NULL );
+
+  if( isStdin() ) {
+    std::cout.rdbuf( std::cerr.rdbuf() );
+    return true;
+  }
+
+  sockaddr_un l_addr;
+  std::memset( &l_addr, 0, sizeof( l_addr ) );
+  l_addr.sun_family = AF_UNIX;
+
+  if( m_endpoint.size() >= sizeof( l_addr.sun_path ) ) {
+    std::cerr << "Socket path " << m_endpoint << " is too long!\n";
+    return false;
+  }
+
+  std::strcpy( l_addr.sun_path, m_endpoint.c_str() );
+
+  //! Only a socket left behind by an earlier server may be replaced
+  struct stat l_st;
+  if( lstat( m_endpoint.c_str(), &l_st ) == 0 && !S_ISSOCK( l_st.st_mode ) ) {
+    std::cerr << "Cannot serve on " << m_endpoint << ": it exists and is not a socket!\n";
+    return false;
+  }
+
+  m_listenFd = socket( AF_UNIX, SOCK_STREAM, 0 );
+  if( m_listenFd == -1 ) {
+    std::cerr << "Failed to create socket: " << std::strerror( errno ) << "\n";
+    return false;
+  }
+
+  unlink( m_endpoint.c_str() );
+  if( bind( m_listenFd, (sockaddr *) &l_addr, sizeof( l_addr ) ) != 0 ||
+      listen( m_listenFd, 16 ) != 0 ) {
+    std::cerr << "Failed to listen on " << m_endpoint << ": " << std::strerror( errno ) << "\n";
+    close( m_listenFd );
+    m_listenFd = -1;
+    return false;
+  }
+
+  std::cout << "Listening on " << m_endpoint << "\n";
+
+  return true;
+}
+
+/** Input params: None
+ *  Return param: Boolean
+ *  Description : Whether to stop (a client sent "quit" or a stop signal came)
+ */
+bool QueryServer::stopping() {
+  if( g_stopSignal )
+    m_quit = true;
+
+  return m_quit;
+}
+
+/** Input params: Request handler
+ *  Return param: Boolean
+ *  Description : Answers requests
+ *
+ *  Serves stdin until it ends, or socket connections one after the other
+ *  until a client sends "quit", then reports the latencies. A SIGTERM or
+ *  SIGINT ends either the same way.
+ */
+bool QueryServer::serve( const Handler &i_handler ) {
+  std::cout << "Serving requests on " << (isStdin() ? "stdin" : m_endpoint) << std::endl;
+
+  if( isStdin() )
+    serveConnection( STDIN_FILENO, STDOUT_FILENO, i_handler );
+
+  while( !isStdin() && !stopping() ) {
+    int l_fd = accept( m_listenFd, NULL, NULL );
+    if( l_fd == -1 && errno == EINTR )
+      continue;
+
+    if( l_fd == -1 ) {
+      std::cerr << "Failed to accept a connection: " << std::strerror( errno ) << "\n";
+      return false;
+    }
+
+    serveConnection( l_fd, l_fd, i_handler );
+    close( l_fd );
+  }
+
+  report();
+
+  return true;
+}
+
+/** Input params: File descriptors to read requests from and write replies
+ *                to, request handler
+ *  Return param: None
+ *  Description : Serves one connection
+ *
+ *  Replies to the complete lines of each read together, so a client sending
+ *  many requests at once gets them back in one write while one waiting for
+ *  each reply gets it right away. Blank lines are ignored.
+ */
+void QueryServer::serveConnection( const int     &i_in,
+                                   const int     &i_out,
+                                   const Handler &i_handler ) {
+  std::vector< char > l_buffer( g_readSize );
+  std::string l_pending;    //! Bytes read but not yet split into lines
+  std::string l_replies;    //! Replies of the lines split so far
+  std::string l_request, l_answer;
+  char        l_time[32];
+  bool        l_eof = false;
+
+  while( !l_eof && !stopping() ) {
+    ssize_t l_n = read( i_in, l_buffer.data(), l_buffer.size() );
+    if( l_n < 0 && errno == EINTR )
+      continue;
+
+    if( l_n <= 0 )
+      l_eof = true;         //! A last line may lack its newline
+    else
+      l_pending.append( l_buffer.data(), (size_t) l_n );
+
+    size_t l_begin = 0, l_end;
+    l_replies.clear();
+
+    while( !m_quit && l_begin < l_pending.size() ) {
+      l_end = l_pending.find( '\n', l_begin );
+      if( l_end == std::string::npos && !l_eof )
+        break;
+      if( l_end == std::string::npos )
+        l_end = l_pending.size();
+
+      l_request.assign( l_pending, l_begin, l_end - l_begin );
+      l_begin = l_end + 1;
+
+      if( !l_request.empty() && l_request.back() == '\r' )
+        l_request.pop_back();
+
+      if( l_request.empty() )
+        continue;
+
+      if( l_request == "quit" ) {
+        m_quit = true;
+        break;
+      }
+
+      std::chrono::high_resolution_clock::time_point l_start;
+      l_start = std::chrono::high_resolution_clock::now();
+
+      l_answer.clear();
+      bool l_ok = i_handler( l_request, l_answer );
+
+      double l_us = std::chrono::duration< double, std::micro >( std::chrono::high_resolution_clock::now() - l_start ).count();
+      m_latencies.add( l_us );
+
+      std::snprintf( l_time, sizeof( l_time ), "%.1f", l_us );
+      l_replies += l_ok ? "ok\t" : "error\t";
+      l_replies += l_time;
+      l_replies += '\t';
+      l_replies += l_answer;
+      l_replies += '\n';
+    }
+
+    l_pending.erase( 0, std::min( l_begin, l_pending.size() ) );
+
+    if( !l_replies.empty() && !writeAll( i_out, l_replies.data(), l_replies.size() ) )
+      return;   //! The client went away
+  }
+}
+
+/** Input params: None
+ *  Return param: None
+ *  Description : Prints the latencies
+ */
+void QueryServer::report() const {
+  if( m_latencies.count() == 0 ) {
+    std::cout << "Served 0 requests\n";
+    return;
+  }
+
+  std::cout << "Served " << m_latencies.count() << " requests: mean " << m_latencies.mean()
+            << " us, median " << m_latencies.percentile( 0.5 )
+            << " us, 99th percentile " << m_latencies.percentile( 0.99 )
+            << " us, max " << m_latencies.max() << " us\n";
+}
+
+/** Input params: Request, actors (passed by reference)
+ *  Return param: Boolean
+ *  Description : Splits a request
+ *
+ *  Same columns as a line of test_pairs_file.
+ */
+bool QueryServer::splitPair( const std::string &i_request,
+                                   std::string &o_actor1,
+                                   std::string &o_actor2 ) {
+  size_t l_tab = i_request.find( '\t' );
+  if( l_tab == std::string::npos || i_request.find( '\t', l_tab + 1 ) != std::string::npos )
+    return false;
+
+  o_actor1 = i_request.substr( 0, l_tab );
+  o_actor2 = i_request.substr( l_tab + 1 );
+
+  return !o_actor1.empty() && !o_actor2.empty();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of class QueryServer, serving actor pairs over stdin or a
+ * Unix domain socket with a line protocol.
+ **/
+
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+
+/** Class answering requests, one per line, until the input ends or a client
+ *  sends "quit". A request is "actor1<TAB>actor2"; its reply is
+ *  "ok<TAB>microseconds<TAB>answer" or "error<TAB>microseconds<TAB>message".
+ */
+class QueryServer {
+public:
+  //! Answers a request (returns false with an error message as the reply)
+  typedef std::function< bool( const std::string &i_request,
+                                     std::string &o_reply ) > Handler;
+
+private:
+  std::string           m_endpoint;   //! Socket path ("-" for stdin and stdout)
+  int                   m_listenFd;   //! Listening socket (-1 for stdin)
+  bool                  m_quit;       //! A client (or a stop signal) asked the server to stop
+  LatencyHistogram      m_latencies;  //! Time taken by the requests
+
+  //! Whether to stop (takes a SIGTERM/SIGINT received as a "quit")
+  bool stopping();
+
+  //! Answer the requests of one connection until it ends
+  void serveConnection( const int     &i_in,
+                        const int     &i_out,
+                        const Handler &i_handler );
+
+public:
+  //! Constructor
+  QueryServer( const std::string &i_endpoint );
+
+  //! Destructor (removes the socket)
+  ~QueryServer();
+
+  //! Whether requests come from stdin
+  bool isStdin() const {
+    return m_endpoint == "-";
+  }
+
+  //! Start listening (stdin: moves the program's messages to stderr)
+  bool open();
+
+  //! Answer requests until stdin ends or a client sends "quit"
+  bool serve( const Handler &i_handler );
+
+  //! Print the number of requests and their latencies
+  void report() const;
+
+  //! Split a request into its 2 actors (false if it hasn't exactly 2 columns)
+  static bool splitPair( const std::string &i_request,
+                               std::string &o_actor1,
+                               std::string &o_actor2 );
+};
+
+#endif //! QUERY_SERVER_H
@@ -0,0 +1,65 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct SplitMix64, the random number generator of the
+ * synthetic movie cast files and the benchmarks.
+ **/
+
+#ifndef SPLIT_MIX64_HPP
+#define SPLIT_MIX64_HPP
+
+#include <cstdint>
+
+/** SplitMix64 generator. Unlike the distributions of <random>, whose output
+ *  is left to the standard library, it gives the same sequence for a seed on
+ *  every platform, so generated files and benchmark inputs are reproducible.
+ */
+struct SplitMix64 {
+  uint64_t m_state;   //! Advanced by each draw
+
+  SplitMix64( const uint64_t &i_seed ) : m_state(i_seed) {}
+
+  //! Next 64 random bits
+  uint64_t next() {
+    uint64_t l_z = (m_state += 0x9e3779b97f4a7c15ULL);
+    l_z = (l_z ^ (l_z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    l_z = (l_z ^ (l_z >> 27)) * 0x94d049bb133111ebULL;
+    return l_z ^ (l_z >> 31);
+  }
+
+  //! Uniform in [0, 1)
+  double uniform() {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  //! Uniform in [0, i_n)
+  int below( const int &i_n ) {
+    return (int) (uniform() * i_n);
+  }
+};
+
+#endif //! SPLIT_MIX64_HPP
@@ -0,0 +1,226 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct TraversalState's member variables holding the
+ * per-query state of a path-finding traversal.
+ **/
+
+#ifndef TRAVERSAL_STATE_HPP
+#define TRAVERSAL_STATE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "DirectionBFS.hpp"
+#include "PathQueue.hpp"
+#include "QueryMetrics.hpp"
+
+/** Distances, previous-actor links and flags of one traversal, indexed by
+ *  global actor-index (movie-id for the expanded flags). Every thread running
+ *  queries owns one, so the graph itself is never written to while searching.
+ *
+ *  Each query has a generation number (epoch), and a distance or flag only
+ *  counts while it carries the current one, so starting the next query is
+ *  just advancing the epoch: nothing the last query touched is walked to
+ *  reset it. A distance is stored as a key with the inverted epoch in its
+ *  upper half, so keys of earlier queries compare greater than any key of
+ *  the current one and relaxing an edge stays a single comparison. The
+ *  previous actor and the edge it was reached through are written with
+ *  every distance, so tracing a path reads them back without a
+ *  lookup. Edges are whatever the traversal passes in: positions in the
+ *  CSR rows, or movies in the actor-movie graph.
+ */
+struct TraversalState {
+  std::vector< uint64_t > m_dist;       //! Distance from source (as key)
+  std::vector< int >      m_prev;       //! Previous actor's index
+  std::vector< int >      m_via;        //! Edge reached through (from the previous actor)
+  std::vector< uint64_t > m_distBack;   //! Distance to target (as key, bidirectional BFS)
+  std::vector< int >      m_next;       //! Next actor's index towards target (bidirectional BFS)
+  std::vector< int >      m_viaBack;    //! Edge leading to the next actor (bidirectional BFS)
+  std::vector< unsigned > m_done;       //! Epoch an actor was settled in (for Djikstra's)
+  std::vector< unsigned > m_isExpanded; //! Epoch a movie was expanded in (bipartite mode)
+  std::vector< unsigned > m_isTarget;   //! Epoch an actor was a target in
+
+  unsigned            m_epoch;        //! Generation of the current query
+  int                 m_numTouched;   //! Actors touched by the current query
+  int                 m_targetsLeft;  //! Targets not yet settled
+  long long           m_numVisited;   //! Actors touched by all queries so far
+
+  DirectionBFS        m_dobfs;        //! Direction-optimizing BFS scratch
+  BucketQueue         m_bucketQueue;  //! Dial's buckets for Djikstra's traversal
+  QueryStats          m_stats;        //! Work of all queries so far
+
+  //! Size the state for a graph
+  void init( const int &i_numActors,
+             const int &i_numMovies ) {
+    m_dist.assign( i_numActors, std::numeric_limits< uint64_t >::max() );
+    m_prev.assign( i_numActors, -1 );
+    m_via.assign( i_numActors, -1 );
+    m_distBack.assign( i_numActors, std::numeric_limits< uint64_t >::max() );
+    m_next.assign( i_numActors, -1 );
+    m_viaBack.assign( i_numActors, -1 );
+    m_done.assign( i_numActors, 0 );
+    m_isExpanded.assign( i_numMovies, 0 );
+    m_isTarget.assign( i_numActors, 0 );
+    m_epoch       = 1;
+    m_numTouched  = 0;
+    m_targetsLeft = 0;
+    m_numVisited  = 0;
+    m_stats.clear();
+  }
+
+  /** Input params: Distance
+   *  Return param: Key of the distance in the current query
+   *  Description : Tags a distance with the current epoch
+   *
+   *  The sign bit of the distance is flipped to keep the order of negative
+   *  ones. Adding an edge-weight to a key gives the key of the sum (as long as
+   *  the sum fits an int), so a traversal computes one key per actor.
+   */
+  uint64_t key( const int &i_dist ) const {
+    return ((uint64_t) ~m_epoch << 32) | ((uint32_t) i_dist ^ 0x80000000u);
+  }
+
+  //! Distance held by a key of the current query (max int for other keys)
+  int distOf( const uint64_t &i_key ) const {
+    if( (uint32_t) (i_key >> 32) != ~m_epoch )
+      return std::numeric_limits< int >::max();
+
+    return (int) ((uint32_t) i_key ^ 0x80000000u);
+  }
+
+  //! Whether the current query touched an actor yet
+  bool isVisited( const int &i_actor ) const {
+    return (uint32_t) (m_dist[i_actor] >> 32) == ~m_epoch ||
+           (uint32_t) (m_distBack[i_actor] >> 32) == ~m_epoch;
+  }
+
+  //! Distance of an actor from the source (max int if not reached)
+  int dist( const int &i_actor ) const {
+    return distOf( m_dist[i_actor] );
+  }
+
+  //! Distance of an actor to the target (max int if not reached)
+  int distBack( const int &i_actor ) const {
+    return distOf( m_distBack[i_actor] );
+  }
+
+  //! Whether a key (of the current query) is less than an actor's distance from the source
+  bool improves( const int      &i_actor,
+                 const uint64_t &i_key ) const {
+    return i_key < m_dist[i_actor];
+  }
+
+  //! Previous actor on the path to a reached actor (-1 for the source)
+  int prev( const int &i_actor ) const {
+    return m_prev[i_actor];
+  }
+
+  //! Edge between a reached actor and its previous actor (-1 for the source)
+  int via( const int &i_actor ) const {
+    return m_via[i_actor];
+  }
+
+  //! Whether an actor is settled (Djikstra's)
+  bool isDone( const int &i_actor ) const {
+    return m_done[i_actor] == m_epoch;
+  }
+
+  //! Mark an actor settled (Djikstra's)
+  void markDone( const int &i_actor ) {
+    m_done[i_actor] = m_epoch;
+  }
+
+  //! Update an actor's distance, previous actor and the edge between them
+  void visit( const int &i_actor,
+              const int &i_dist,
+              const int &i_prev,
+              const int &i_via = -1 ) {
+    if( !isVisited( i_actor ) )
+      ++m_numTouched;
+
+    m_dist[i_actor] = key( i_dist );
+    m_prev[i_actor] = i_prev;
+    m_via[i_actor]  = i_via;
+  }
+
+  //! Update an actor's distance to and next actor towards the target
+  void visitBack( const int &i_actor,
+                  const int &i_dist,
+                  const int &i_next,
+                  const int &i_via = -1 ) {
+    if( !isVisited( i_actor ) )
+      ++m_numTouched;
+
+    m_distBack[i_actor] = key( i_dist );
+    m_next[i_actor]     = i_next;
+    m_viaBack[i_actor]  = i_via;
+  }
+
+  //! Mark an actor as a target of the current query
+  void addTarget( const int &i_actor ) {
+    if( m_isTarget[i_actor] == m_epoch )
+      return;
+
+    m_isTarget[i_actor] = m_epoch;
+    ++m_targetsLeft;
+  }
+
+  //! Note an actor as settled (returns true once it was the last target)
+  bool settle( const int &i_actor ) {
+    return m_isTarget[i_actor] == m_epoch && --m_targetsLeft == 0;
+  }
+
+  //! Mark a movie expanded (returns false if it already was)
+  bool expand( const int &i_movie ) {
+    if( m_isExpanded[i_movie] == m_epoch )
+      return false;
+
+    m_isExpanded[i_movie] = m_epoch;
+    return true;
+  }
+
+  //! Start the next query (clears the stamps only when the epoch wraps around)
+  void reset() {
+    m_numVisited += m_numTouched;
+    m_numTouched  = 0;
+    m_targetsLeft = 0;
+
+    if( ++m_epoch == 0 ) {
+      std::fill( m_dist.begin(), m_dist.end(), std::numeric_limits< uint64_t >::max() );
+      std::fill( m_distBack.begin(), m_distBack.end(), std::numeric_limits< uint64_t >::max() );
+      std::fill( m_done.begin(), m_done.end(), 0 );
+      std::fill( m_isExpanded.begin(), m_isExpanded.end(), 0 );
+      std::fill( m_isTarget.begin(), m_isTarget.end(), 0 );
+      m_epoch = 1;
+    }
+  }
+};
+
+#endif //! TRAVERSAL_STATE_HPP
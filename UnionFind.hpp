@@ -32,22 +32,58 @@
 #ifndef UNIONFIND_HPP
 #define UNIONFIND_HPP
 
-#include <set>
-
 #include "ActorGraph.h"
+#include "DirectionBFS.hpp"
+#include "DisjointSet.hpp"
+#include "YearIndex.hpp"
+
+//! Per-year adjacency lists of the actors, as searched by DirectionBFS (edges given as their movie)
+struct YearAdjacency {
+  const std::vector< Actor * > &m_graph;     //! Actor nodes
+  long long                     m_numEdges;  //! Directed edges of the year(s) constructed
+
+  int numNodes() const {
+    return (int) m_graph.size();
+  }
+
+  long long numEdges() const {
+    return m_numEdges;
+  }
+
+  int degree( const int &i_node ) const {
+    return (int) m_graph[i_node]->m_adj.size();
+  }
+
+  template< class Visit >
+  bool scan( const int   &i_node,
+                   Visit  i_visit ) const {
+    for( const std::pair< const int, Edge * > &l_edge : m_graph[i_node]->m_adj )
+      if( i_visit( l_edge.first, l_edge.second->m_movie ) )
+        return true;
+
+    return false;
+  }
+};
 
 //! Class for actor connections, inheriting publically from ActorGraph
 class ActorConnect : public ActorGraph {
 protected:
-  std::set< int >            m_movieYears;   //! Set of movie years
-  std::set< int >::iterator  m_mit;          //! Movie year iterator
-  std::vector< int >         m_dsArr;        //! Disjoint Set array
+  YearIndex                  m_yearIndex;    //! Movies of each year
+  DisjointSet< int >         m_sets;         //! Disjoint sets of actors
+  long long                  m_numEdges;     //! Edges in the per-year adjacency lists
+  std::vector< char >        m_reached;      //! Actors reached from the source (bfs)
+  std::vector< int >         m_reachedList;  //! Actors reached, to reset them
+  DirectionBFS               m_dobfs;        //! Direction-optimizing BFS scratch
+  QueryStats                 m_stats;        //! Work of all pairs so far
+
+  //! Edges added by the last constructEdges < actor1, actor2 >
+  std::vector< std::pair< int, int > >  m_newEdges;
 
   //! Extract years from the graph in ascending order
   void extractYearsInAscOrder();
 
-  //! Construct edges in the graph for a given year
-  void constructEdges( const int &i_year );
+  //! Construct edges in the graph for a given year (position in the year index)
+  void constructEdges( const int &i_y );
 
   //! Delete all edges in the graph
   void deleteEdges();
@@ -57,106 +93,116 @@ protected:
                            const int         &i_id1,
                            const int         &i_id2 );
 
-  //! Perform BFS traversal to find actor connections
-  bool pairBFSTraverse( const int &i_from,
-                        const int &i_to );
+  //! Start the actors reached from a node over the years
+  void startReach( const int &i_from );
 
-  //! Find an actor in the disjoint set array
-  int Find( const int &i_index,
-                  int &o_height );
+  //! Extend the actors reached over the edges of the last year to find actor connections
+  bool pairIncrementalBFSTraverse( const int &i_to );
 
-  //! Perform union of disjoint sets
-  void Union( const int &i_id1,
-              const int &i_id2 );
+  //! Perform direction-optimizing BFS traversal to find actor connections
+  bool pairDirectionBFSTraverse( const int &i_from,
+                                 const int &i_to );
 
-  //! Constructs the disjoint set array for a given year
-  void constructArr( const int &i_year );
+  //! Constructs the disjoint set array for a given year (position in the year index)
+  void constructArr( const int &i_y );
 
   //! Perform union-find traversal to finf actor connections
   bool pairUFindTraverse( const int &i_from,
                           const int &i_to );
 
+  //! Write the metrics line of a pair
+  void logConnection( const std::string &i_actor1,
+                      const std::string &i_actor2,
+                      const std::string &i_year,
+                      const QueryStats  &i_stats );
+
+  //! Announce the algorithm and index the years
+  void startAlgorithm( const std::string &i_algo );
+
+  //! Connect all pairs in one union-find sweep over the years
+  void sweepPairs( const std::vector< std::pair< int, int > > &i_pairs,
+                         std::vector< std::string >           &o_years );
+
 public:
   //! Constructor
   ActorConnect( const std::string &i_outLine );
 
+  //! Builds the Kruskal reconstruction tree of the years (unless already loaded)
+  bool buildConnectionIndex();
+
   //! Connect actors from input actor pair file
   bool connectActors( const char        *i_infile,
                       const std::string &i_algo );
+
+  //! Connect the pairs sent to a query server until it stops
+  bool serveConnections( QueryServer       &io_server,
+                         const std::string &i_algo );
 };
 
 /** Input params: First line to output in file
  *  Return param: None
  *  Description : Constructor
  */
-ActorConnect::ActorConnect( const std::string &i_outLine ) : ActorGraph( i_outLine ) {}
+ActorConnect::ActorConnect( const std::string &i_outLine ) : ActorGraph( i_outLine ),
+                                                             m_numEdges(0) {
+  m_idHeader = i_outLine;   //! Same columns, holding actor ids
+}
 
 /** Input params: None
  *  Return param: None
- *  Description : Constructor
+ *  Description : Extract years
  *
- *  Populates the set with movie years in an ascending order.
+ *  Groups the movies by year in an ascending order (once).
  */
 void ActorConnect::extractYearsInAscOrder() {
-  for( m_aim = m_actorsInMovie.begin(); m_aim != m_actorsInMovie.end(); ++m_aim )
-    m_movieYears.insert( extractYear( m_aim->first ) ); //! Insert into set
+  if( m_yearIndex.empty() )
+    m_yearIndex.build( m_movieTable );
 }
 
-/** Input params: Year
+/** Input params: Position of the year in the year index
  *  Return param: None
  *  Description : Construct edges
  *
- *  Construct edges between actor nodes for movies of a particular year only.
+ *  Construct edges between actor nodes for movies of a particular year only,
+ *  i.e. between every 2 actors of the cast of each of these movies. The
+ *  edges new to the graph are listed in m_newEdges.
  */
-void ActorConnect::constructEdges( const int &i_year ) {
+void ActorConnect::constructEdges( const int &i_y ) {
   Actor *l_actor;       //! Actor node
   Edge  *l_edge;        //! Edge between actors
-  int    l_id1, l_id2;  //! Indices of the actors
-
-  //! *moa is actor
-  for( m_moa = m_moviesOfActor.begin(); m_moa != m_moviesOfActor.end(); ++m_moa ) {
-    for( m_vit = (m_moa->second).begin(); m_vit != (m_moa->second).end(); ++m_vit ) {
-      //! *vit is movie of actor (only consider movies matching year)
-      if( extractYear( *m_vit ) != i_year )
-        continue;
-
-      m_aim = m_actorsInMovie.find( *m_vit );   //! *aim is movie
-      if( m_aim != m_actorsInMovie.end() ) {
-        for( m_sit = (m_aim->second).begin(); m_sit != (m_aim->second).end(); ++m_sit ) {
-          //! *sit is list of actors in movie
-
-          //! Skip self
-          if( (m_moa->first).compare( *m_sit ) == 0 )
-            continue;
-
-          //! Get index of actor1
-          m_ioa   = m_indexOfActor.find( m_moa->first );
-          l_id1   = m_ioa->second;
-          l_actor = m_theGraph[l_id1];
-
-          //! Get index of actor2
-          m_ioa   = m_indexOfActor.find( *m_sit );
-          l_id2   = m_ioa->second;
-          m_eit   = l_actor->m_adj.find( l_id2 );
-
-          //! Construct a new edge if one doesn't exist between actor1-actor2
-          if( m_eit == l_actor->m_adj.end() ) {
-            l_edge                = new Edge;
-            l_edge->m_movie       = *m_vit;
-            l_edge->m_weight      = 1;
-            l_actor->m_adj[l_id2] = l_edge;
-          }
-
-          l_actor = m_theGraph[l_id2];
-          m_eit   = l_actor->m_adj.find( l_id1 );
-
-          //! Edge needs to be two-way hence construct for actor2-actor1
-          if( m_eit == l_actor->m_adj.end() ) {
-            l_edge                = new Edge;
-            l_edge->m_movie       = *m_vit;
-            l_edge->m_weight      = 1;
-            l_actor->m_adj[l_id1] = l_edge;
-          }
+  int    l_id1, l_id2;  //! Indices of the co-stars
+  int    l_movie;       //! Movie-id
+
+  m_newEdges.clear();
+
+  for( int l_m = m_yearIndex.m_offsets[i_y]; l_m < m_yearIndex.m_offsets[i_y + 1]; ++l_m ) {
+    //! l_movie is movie of the year
+    l_movie = m_yearIndex.m_movieIds[l_m];
+
+    for( int l_c1 = m_bip.m_castOffsets[l_movie]; l_c1 < m_bip.m_castOffsets[l_movie + 1]; ++l_c1 ) {
+      //! l_id1 is actor in movie
+      l_id1   = m_bip.m_castIds[l_c1];
+      l_actor = m_theGraph[l_id1];
+
+      for( int l_c2 = m_bip.m_castOffsets[l_movie]; l_c2 < m_bip.m_castOffsets[l_movie + 1]; ++l_c2 ) {
+        //! l_id2 is co-star in movie
+        l_id2 = m_bip.m_castIds[l_c2];
+
+        //! Skip self
+        if( l_id1 == l_id2 )
+          continue;
+
+        m_eit = l_actor->m_adj.find( l_id2 );
+
+        //! Construct a new edge if one doesn't exist between actor1-actor2
+        //! (actor2-actor1 is constructed when actor2 comes up as l_id1)
+        if( m_eit == l_actor->m_adj.end() ) {
+          l_edge                = m_edgePool.create();
+          l_edge->m_movie       = l_movie;
+          l_edge->m_weight      = 1;
+          l_actor->m_adj[l_id2] = l_edge;
+          m_newEdges.push_back( std::make_pair( l_id1, l_id2 ) );
+          ++m_numEdges;
         }
       }
     }
@@ -167,15 +213,15 @@ void ActorConnect::constructEdges( const int &i_year ) {
  *  Return param: None
  *  Description : Delete edges
  *
- *  Clears the adjacency list of each actor in the graph.
+ *  Clears the adjacency list of each actor in the graph and drops all edges
+ *  at once, keeping the pool's blocks for the next pair's edges.
  */
 void ActorConnect::deleteEdges() {
-  for( m_ait = m_theGraph.begin(); m_ait != m_theGraph.end(); ++m_ait ) {
-    for( m_eit = (*m_ait)->m_adj.begin(); m_eit != (*m_ait)->m_adj.end(); ++m_eit )
-      delete (*m_eit).second;
-
+  for( m_ait = m_theGraph.begin(); m_ait != m_theGraph.end(); ++m_ait )
     (*m_ait)->m_adj.clear();  //! Clear the hash-map of all entries
-  }
+
+  m_edgePool.clear();
+  m_numEdges = 0;
 }
 
 /** Input params: Traverse algorithm, indices of actors
@@ -187,31 +233,40 @@ void ActorConnect::deleteEdges() {
 std::string ActorConnect::connectPair( const std::string  &i_algorithm,
                                        const int          &i_id1,
                                        const int          &i_id2 ) {
-  if( i_algorithm == "bfs" )
+  //! The index knows the year right away
+  if( i_algorithm == "index" ) {
+    int l_year = m_connections.connectedSince( i_id1, i_id2 );
+    return l_year == -1 ? "9999" : std::to_string( l_year );
+  }
+
+  if( i_algorithm != "ufind" )
     deleteEdges();  //! Clear hash-map of edges before venturing to next pair
+
+  if( i_algorithm == "bfs" )
+    startReach( i_id1 );
   else
-    m_dsArr = std::vector< int >( m_theGraph.size(), -1 ); //! Array of indices to -1
+    m_sets.reset( (int) m_theGraph.size() );  //! Every actor in a set of its own
 
-  //! *mit is pair of year and bool-flag in set (in ascending order)
-  for( m_mit = m_movieYears.begin(); m_mit != m_movieYears.end(); ++m_mit ) {
-    if( i_algorithm == "bfs" ) {
+  //! l_y is position of the year in the year index (in ascending order)
+  for( int l_y = 0; l_y < m_yearIndex.numYears(); ++l_y ) {
+    if( i_algorithm != "ufind" ) {
       //! Construct edges for a particular year
-      constructEdges( *m_mit );
+      constructEdges( l_y );
 
       //! Perform BFS traversal, if unsuccessful, increment year and try again
-      if( !pairBFSTraverse( i_id1, i_id2 ) )
+      if( i_algorithm == "dobfs" ? !pairDirectionBFSTraverse( i_id1, i_id2 ) : !pairIncrementalBFSTraverse( i_id2 ) )
         continue;
       else
-        return std::to_string( *m_mit );
+        return std::to_string( m_yearIndex.m_years[l_y] );
     } else {
       //! Construct disjoint set array for each year
-      constructArr( *m_mit );
+      constructArr( l_y );
 
       //! Perform union-find traversal till successful
       if( !pairUFindTraverse( i_id1, i_id2 ) )
         continue;
       else
-        return std::to_string( *m_mit );
+        return std::to_string( m_yearIndex.m_years[l_y] );
     }
   }
 
@@ -221,184 +276,340 @@ std::string ActorConnect::connectPair( const std::string  &i_algorithm,
   return "9999";
 }
 
-/** Input params: Indices in graph to traverse from and to
- *  Return param: Boolean
- *  Description : BFS traversal
+/** Input params: Index in graph to traverse from
+ *  Return param: None
+ *  Description : Start reachability
  *
- *  Performs a BFS traversal between the actors and return success state.
+ *  Forgets the actors reached from the previous pair's source; only the new
+ *  source is reached before any edge exists.
  */
-bool ActorConnect::pairBFSTraverse( const int &i_from,
-                                    const int &i_to ) {
-  std::queue< Actor * >  l_toExplore;    //! Queue to explore
-  std::vector< Actor * > l_visited;      //! Visited nodes during traversal
-
-  Actor *l_next, *l_neighbor;         //! Actor nodes
-  bool l_found    = false;          //! Flag stating success of traversal
-
-  Actor *l_start  = m_theGraph[i_from]; //! Initial node
-  Actor *l_end    = m_theGraph[i_to];   //! End node
-
-  //! Intial node conditioning
-  l_start->m_dist   = 0;
-  l_toExplore.push( l_start );
-  l_visited.push_back( l_start );
-
-  //! Traverse till queue isn't empty
-  while( !l_toExplore.empty() ) {
-    //! Get front element from queue
-    l_next  = l_toExplore.front();
-    l_toExplore.pop();
+void ActorConnect::startReach( const int &i_from ) {
+  if( m_reached.size() != m_theGraph.size() )
+    m_reached.assign( m_theGraph.size(), 0 );
 
-    //! Break if traverse was successful
-    if( l_next == l_end ) {
-      l_found = true;
-      break;
-    }
+  for( int l_index : m_reachedList )
+    m_reached[l_index] = 0;
 
-    //! Breadth-first search algorithm
-    for( m_eit = l_next->m_adj.begin(); m_eit != l_next->m_adj.end(); ++m_eit ) {
-      l_neighbor  = m_theGraph[m_eit->first];
+  m_reachedList.clear();
+  m_reached[i_from] = 1;
+  m_reachedList.push_back( i_from );
+}
 
-      if( (l_next->m_dist + 1) < l_neighbor->m_dist ) {
-        l_neighbor->m_dist  = l_next->m_dist + 1;
-        l_neighbor->m_prev  = l_next->m_index;
-        l_toExplore.push( l_neighbor );
-        l_visited.push_back( l_neighbor );
-      }
+/** Input params: Index in graph to traverse to
+ *  Return param: Boolean
+ *  Description : Incremental BFS traversal
+ *
+ *  The actors reached from the source only grow as edges are added year by
+ *  year, so instead of a BFS over all years' edges, the BFS only starts from
+ *  the far ends of this year's new edges leaving the reached actors, and
+ *  only enters actors not reached before. Over all years of a pair this
+ *  touches every edge at most once.
+ */
+bool ActorConnect::pairIncrementalBFSTraverse( const int &i_to ) {
+  std::queue< int > l_toExplore;   //! Queue to explore
+  int               l_next;        //! Actor being expanded
+
+  //! New edges out of the reached actors
+  m_stats.m_scanned += (long long) m_newEdges.size();
+  for( const std::pair< int, int > &l_edge : m_newEdges ) {
+    if( m_reached[l_edge.first] && !m_reached[l_edge.second] ) {
+      m_reached[l_edge.second] = 1;
+      m_reachedList.push_back( l_edge.second );
+      l_toExplore.push( l_edge.second );
+      ++m_stats.m_pushes;
     }
   }
 
-  //! Reset distances and previous info for all visited nodes during traversal
-  for( m_ait = l_visited.begin(); m_ait != l_visited.end(); ++m_ait ) {
-    (*m_ait)->m_dist = std::numeric_limits< int >::max();
-    (*m_ait)->m_prev = -1;
+  //! Traverse till queue isn't empty (or the target is reached)
+  while( !l_toExplore.empty() && !m_reached[i_to] ) {
+    l_next = l_toExplore.front();
+    l_toExplore.pop();
+    ++m_stats.m_popped;
+    m_stats.m_scanned += (long long) m_theGraph[l_next]->m_adj.size();
+
+    //! Breadth-first search algorithm over the edges of all years so far
+    for( m_eit = m_theGraph[l_next]->m_adj.begin(); m_eit != m_theGraph[l_next]->m_adj.end(); ++m_eit ) {
+      if( !m_reached[m_eit->first] ) {
+        m_reached[m_eit->first] = 1;
+        m_reachedList.push_back( m_eit->first );
+        l_toExplore.push( m_eit->first );
+        ++m_stats.m_pushes;
+      }
+    }
   }
 
   //! Return success flag
-  return l_found;
+  return m_reached[i_to];
 }
 
-/** Input params: Actor index and height of disjoint set (passed by reference)
- *  Return param: Sentinel node index
- *  Description : Find actor in the disjoint set array
+/** Input params: Indices in graph to traverse from and to
+ *  Return param: Boolean
+ *  Description : Direction-optimizing BFS traversal
  *
- *  Finds an actor in the disjoint set array and returns index of sentinel node.
+ *  Performs a BFS traversal between the actors over the edges constructed
+ *  so far, switching to bottom-up steps once the frontier gets large.
  */
-int ActorConnect::Find( const int &i_index,
-                              int &o_height ) {
-  int l_val = m_dsArr[i_index]; //! Value of disjoint set at index
-  int l_ind = i_index;        //! Stores sentinel node info
-  std::vector< int > l_indices;  //! Nodes traversed during find (for path compression)
-
-  while( l_val != -1 ) {
-    l_indices.push_back( l_ind );
-    l_ind = l_val;
-    l_val = m_dsArr[l_val];
-    o_height++;
-  }
+bool ActorConnect::pairDirectionBFSTraverse( const int &i_from,
+                                             const int &i_to ) {
+  YearAdjacency l_adjacency = { m_theGraph, m_numEdges };
+
+  bool l_found = m_dobfs.search( l_adjacency, i_from, i_to );
 
-  //! Path-compression algorithm (for disjoint sets having height greater than 1)
-  if( o_height > 1 )
-    for( std::vector< int >::iterator l_it = l_indices.begin(); l_it != l_indices.end(); ++l_it )
-      m_dsArr[*l_it] = l_ind;
+  m_stats.m_popped  += m_dobfs.numExpanded();
+  m_stats.m_scanned += m_dobfs.numScanned();
+  m_stats.m_pushes  += m_dobfs.numVisited();
 
-  //! Return index of sentinel node
-  return l_ind;
+  return l_found;
 }
 
-/** Input params: Indices of actor nodes to unite
+/** Input params: Position of the year in the year index
  *  Return param: None
- *  Description : Perform union of two actors
+ *  Description : Constructs disjoint set array for a given year
  *
- *  Performs union operation on the disjoint set array.
+ *  Performs union operation on actors connected by movie of given year (the
+ *  first actor of each cast with every other one).
  */
-void ActorConnect::Union( const int &i_id1,
-                          const int &i_id2 ) {
-  int l_height1 = 0, l_height2 = 0;
-  int l_find1 = Find( i_id1, l_height1 );   //! Sentinel node-index of actor1
-  int l_find2 = Find( i_id2, l_height2 );   //! Sentinel node-index of actor2
-
-  //! Perform union operation
-  if( l_find1 != l_find2 ) {
-    if( l_height1 < l_height2 )
-      m_dsArr[l_find1] = l_find2;
-    else
-      m_dsArr[l_find2] = l_find1;
+void ActorConnect::constructArr( const int &i_y ) {
+  int l_movie;  //! Movie-id
+  int l_first;  //! First actor of the cast
+
+  for( int l_m = m_yearIndex.m_offsets[i_y]; l_m < m_yearIndex.m_offsets[i_y + 1]; ++l_m ) {
+    //! l_movie is movie of the year
+    l_movie = m_yearIndex.m_movieIds[l_m];
+    if( m_bip.m_castOffsets[l_movie] == m_bip.m_castOffsets[l_movie + 1] )
+      continue;
+
+    l_first = m_bip.m_castIds[m_bip.m_castOffsets[l_movie]];
+    m_stats.m_unions += m_bip.m_castOffsets[l_movie + 1] - m_bip.m_castOffsets[l_movie] - 1;
+    m_stats.m_finds  += 2 * (m_bip.m_castOffsets[l_movie + 1] - m_bip.m_castOffsets[l_movie] - 1);
+    for( int l_c = m_bip.m_castOffsets[l_movie] + 1; l_c < m_bip.m_castOffsets[l_movie + 1]; ++l_c )
+      m_sets.unite( l_first, m_bip.m_castIds[l_c] );  //! Perform union operation for the actors
   }
 }
 
-/** Input params: Year
+/** Input params: Indices to traverse graph from and to
+ *  Return param: Boolean state
+ *  Description : Traverse graph using union-find
+ *
+ *  Performs a union-find traversal between the actors and return success state).
+ */
+bool ActorConnect::pairUFindTraverse( const int &i_from,
+                                      const int &i_to ) {
+  //! UFind traversal was successfull if both actors have the same sentinel
+  m_stats.m_finds += 2;
+  return m_sets.same( i_from, i_to );
+}
+
+/** Input params: Pairs of actor indices, years they got connected (passed by
+ *                reference)
  *  Return param: None
- *  Description : Constructs disjoint set array for a given year
+ *  Description : Connect all pairs in one sweep
  *
- *  Performs union operation on actors connected by movie of given year.
+ *  Offline version of the union-find traversal: instead of rebuilding the
+ *  disjoint sets for every pair, the casts of the movies are united year
+ *  after year into a single disjoint set array.
+ *  After each year, every pair still pending whose actors just ended up in
+ *  the same set gets connected in that year.
  */
-void ActorConnect::constructArr( const int &i_year ) {
-  int l_id1, l_id2;
+void ActorConnect::sweepPairs( const std::vector< std::pair< int, int > > &i_pairs,
+                                     std::vector< std::string >           &o_years ) {
+  std::vector< int > l_pending;   //! Pairs not connected yet
+  std::vector< int > l_left;      //! Pairs still not connected after a year
+
+  o_years.assign( i_pairs.size(), "9999" );
+
+  for( size_t l_p = 0; l_p < i_pairs.size(); ++l_p )
+    l_pending.push_back( (int) l_p );
+
+  m_sets.reset( (int) m_theGraph.size() );  //! Every actor in a set of its own
+
+  for( int l_y = 0; l_y < m_yearIndex.numYears() && !l_pending.empty(); ++l_y ) {
+    //! Unite the cast of every movie of the year
+    constructArr( l_y );
+
+    //! Resolve the pairs connected by now
+    l_left.clear();
+    for( int l_p : l_pending ) {
+      if( pairUFindTraverse( i_pairs[l_p].first, i_pairs[l_p].second ) )
+        o_years[l_p] = std::to_string( m_yearIndex.m_years[l_y] );
+      else
+        l_left.push_back( l_p );
+    }
+
+    l_pending.swap( l_left );
+  }
+}
+
+/** Input params: None
+ *  Return param: Boolean (false if an index was mapped from a snapshot)
+ *  Description : Builds the connection index
+ *
+ *  Runs the union-find sweep over the movies in year order once, adding a
+ *  node to the Kruskal reconstruction tree for every union that joins 2
+ *  sets, then cuts the tree into heavy paths. Children always get lower
+ *  node numbers than their parent, so both passes are plain loops over the
+ *  nodes.
+ */
+bool ActorConnect::buildConnectionIndex() {
+  int l_numActors = (int) m_theGraph.size();
+
+  if( !m_connections.empty() || l_numActors == 0 )
+    return false;
+
+  std::chrono::high_resolution_clock::time_point l_start;
+  l_start = std::chrono::high_resolution_clock::now();
+
+  std::vector< int > l_parent( l_numActors, -1 );  //! Parent of each node
+  std::vector< int > l_year;                     //! Year of each node
+  std::vector< int > l_top( l_numActors );       //! Tree node of each set (at its sentinel)
+  int                l_find1, l_find2;           //! Sentinels of the actors being united
+
+  extractYearsInAscOrder();
+
+  //! Leaves get the earliest year (an actor is connected to itself from the start)
+  l_year.assign( l_numActors, m_yearIndex.m_years.empty() ? 0 : m_yearIndex.m_years[0] );
+  l_parent.reserve( 2 * l_numActors - 1 );
+  l_year.reserve( 2 * l_numActors - 1 );
+
+  for( int l_index = 0; l_index < l_numActors; ++l_index )
+    l_top[l_index] = l_index;
+
+  m_sets.reset( l_numActors );  //! Every actor in a set of its own
+
+  //! Movies in year order
+  for( size_t l_m = 0; l_m < m_yearIndex.m_movieIds.size(); ++l_m ) {
+    int l_movie = m_yearIndex.m_movieIds[l_m];
+    if( m_bip.m_castOffsets[l_movie] == m_bip.m_castOffsets[l_movie + 1] )
+      continue;
+
+    int l_first = m_bip.m_castIds[m_bip.m_castOffsets[l_movie]];
 
-  for( m_moa = m_moviesOfActor.begin(); m_moa != m_moviesOfActor.end(); ++m_moa ) {
-    for( m_vit = (m_moa->second).begin(); m_vit != (m_moa->second).end(); ++m_vit ) {
-      //! *vit is movie of actor
-      if( extractYear( *m_vit ) != i_year )
+    for( int l_c = m_bip.m_castOffsets[l_movie] + 1; l_c < m_bip.m_castOffsets[l_movie + 1]; ++l_c ) {
+      l_find1 = m_sets.find( l_first );
+      l_find2 = m_sets.find( m_bip.m_castIds[l_c] );
+      if( l_find1 == l_find2 )
         continue;
 
-      m_aim = m_actorsInMovie.find( *m_vit );   //! *aim is movie
-      if( m_aim != m_actorsInMovie.end() ) {
-        for( m_sit = (m_aim->second).begin(); m_sit != (m_aim->second).end(); ++m_sit ) {
-          //! *sit is list of actors in movie
+      //! New node joining both sets in the year of the movie
+      l_parent[l_top[l_find1]] = (int) l_parent.size();
+      l_parent[l_top[l_find2]] = (int) l_parent.size();
+      l_parent.push_back( -1 );
+      l_year.push_back( m_movieTable.m_years[l_movie] );
 
-          //! Skip self
-          if( (m_moa->first).compare( *m_sit ) == 0 )
-            continue;
+      m_sets.unite( l_find1, l_find2 );
+      l_top[m_sets.find( l_find1 )] = (int) l_parent.size() - 1;
+    }
+  }
 
-          //! Get index of actor1
-          m_ioa   = m_indexOfActor.find( m_moa->first );
-          l_id1   = m_ioa->second;
+  //! Disconnected actors leave a forest with fewer nodes
+  int l_numNodes = (int) l_parent.size();
 
-          //! Get index of actor2
-          m_ioa   = m_indexOfActor.find( *m_sit );
-          l_id2   = m_ioa->second;
+  std::vector< int > l_size( l_numNodes, 1 );   //! Nodes in the subtree of each node
+  std::vector< int > l_heavy( l_numNodes, -1 ); //! Child with the most leaves
+  std::vector< int > l_depth( l_numNodes, 0 );
+  std::vector< int > l_head( l_numNodes );
 
-          //! Perform union operation for the actors
-          Union( l_id1, l_id2 );
-        }
-      }
+  for( int l_node = 0; l_node < l_numNodes; ++l_node ) {
+    int l_up = l_parent[l_node];
+    if( l_up == -1 )
+      continue;
+
+    l_size[l_up] += l_size[l_node];
+  }
+
+  for( int l_node = 0; l_node < l_numNodes; ++l_node ) {
+    int l_up = l_parent[l_node];
+    if( l_up != -1 && (l_heavy[l_up] == -1 || l_size[l_node] > l_size[l_heavy[l_up]]) )
+      l_heavy[l_up] = l_node;
+  }
+
+  for( int l_node = l_numNodes - 1; l_node >= 0; --l_node ) {
+    int l_up = l_parent[l_node];
+    if( l_up == -1 )
+      l_head[l_node] = l_node;
+    else {
+      l_depth[l_node] = l_depth[l_up] + 1;
+      l_head[l_node]  = (l_heavy[l_up] == l_node) ? l_head[l_up] : l_node;
     }
   }
+
+  m_connections = ConnectionIndex();
+  m_connections.m_parent.append( l_parent.data(), l_parent.size() );
+  m_connections.m_year.append( l_year.data(), l_year.size() );
+  m_connections.m_depth.append( l_depth.data(), l_depth.size() );
+  m_connections.m_head.append( l_head.data(), l_head.size() );
+
+  double l_secs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - l_start ).count();
+  std::cout << "Connection index: " << l_numNodes << " nodes, " << m_connections.bytes() / (1024.0 * 1024.0)
+            << " MB, built in " << l_secs << "s\n";
+
+  return true;
 }
 
-/** Input params: Indices to traverse graph from and to
- *  Return param: Boolean state
- *  Description : Traverse graph using union-find
- *
- *  Performs a union-find traversal between the actors and return success state).
+/** Input params: Actor names, year they got connected, counters of the pair
+ *  Return param: None
+ *  Description : Logs a pair
  */
-bool ActorConnect::pairUFindTraverse( const int &i_from,
-                                      const int &i_to ) {
-  int l_height1 = 0, l_height2 = 0;
-  int l_find1 = Find( i_from, l_height1 );  //! Sentinel index of initial node
-  int l_find2 = Find( i_to, l_height2 );    //! Sentinel index of end node
+void ActorConnect::logConnection( const std::string &i_actor1,
+                                  const std::string &i_actor2,
+                                  const std::string &i_year,
+                                  const QueryStats  &i_stats ) {
+  std::string l_members;
+
+  if( m_metrics.enabled() ) {
+    l_members = "\"from\":";
+    MetricsLog::appendString( i_actor1, l_members );
+    l_members += ",\"to\":";
+    MetricsLog::appendString( i_actor2, l_members );
+    l_members += ",\"year\":" + i_year;
+  }
+
+  m_metrics.query( l_members, i_stats );
+}
+
+/** Input params: Traversal algorithm
+ *  Return param: None
+ *  Description : Starts an algorithm
+ */
+void ActorConnect::startAlgorithm( const std::string &i_algo ) {
+  if( i_algo == "bfs" )
+    std::cout << "Running BFS\n";
+  else if( i_algo == "dobfs" )
+    std::cout << "Running direction-optimizing BFS\n";
+  else if( i_algo == "sweep" )
+    std::cout << "Running UFind sweep\n";
+  else if( i_algo == "index" )
+    std::cout << "Running connection index\n";
+  else
+    std::cout << "Running UFind\n";
 
-  //! UFind traversal was successfull if both sentinel indices were equal
-  return (l_find1 == l_find2);
+  extractYearsInAscOrder();
 }
 
 /** Input params: Input filename and traversal algorithm
  *  Return param: Boolean
  *  Description : Connect actors in input actor-pair file
+ *
+ *  With the sweep algorithm all pairs are read first and then connected in
+ *  one pass; otherwise each pair is connected and written out as it is read.
  */
 bool ActorConnect::connectActors( const char        *i_infile,
                                   const std::string &i_algo ) {
-  bool l_flag = false;
+  bool l_flag;
   int l_id1, l_id2;
   std::string l_s;
 
-  if( i_algo == "bfs" )
-    std::cout << "Running BFS\n";
-  else
-    std::cout << "Running UFind\n";
+  std::vector< std::pair< int, int > > l_sweepPairs;  //! Pairs left for the sweep
+  std::vector< std::string >           l_sweepLines;  //! Output lines held for the sweep
+  std::vector< size_t >                l_sweepSlots;  //! Line of each pair of the sweep
+  std::vector< std::string >           l_sweepYears;  //! Years they got connected
+  std::string                          l_year;        //! Year of the current pair
+  QueryStats                           l_before;      //! Counters before the current pair
 
-  extractYearsInAscOrder();
+  std::chrono::high_resolution_clock::time_point l_phase, l_start;
+  l_phase = std::chrono::high_resolution_clock::now();
+
+  startAlgorithm( i_algo );
 
   //! Open the test_pairs_file
   std::ifstream l_in( i_infile );
@@ -434,32 +645,120 @@ bool ActorConnect::connectActors( const char        *i_infile,
     std::string l_actor1( l_pairs[0] );
     std::string l_actor2( l_pairs[1] );
 
+    l_flag = false;
+
     //! Get index of actor1
-    m_ioa = m_indexOfActor.find( l_actor1 );
-    if( m_ioa == m_indexOfActor.end() )
+    l_id1 = findActor( l_actor1 );
+    if( l_id1 == -1 )
       l_flag = true;
-    else
-      l_id1 = m_ioa->second;
 
     //! Get index of actor2
-    m_ioa = m_indexOfActor.find( l_actor2 );
-    if( m_ioa == m_indexOfActor.end() )
+    l_id2 = findActor( l_actor2 );
+    if( l_id2 == -1 )
       l_flag = true;
-    else
-      l_id2 = m_ioa->second;
 
-    std::string l_line = l_actor1 + "\t" + l_actor2 + "\t";
+    std::string l_line = m_idOutput ? std::to_string( l_id1 ) + "\t" + std::to_string( l_id2 ) + "\t"
+                                    : l_actor1 + "\t" + l_actor2 + "\t";
+
+    //! Try and find connection between the pair (later, for the sweep)
+    if( !l_flag && i_algo == "sweep" ) {
+      l_sweepPairs.push_back( std::make_pair( l_id1, l_id2 ) );
+      l_sweepSlots.push_back( l_sweepLines.size() );
+    } else {
+      l_before = m_stats;
+      l_start  = std::chrono::high_resolution_clock::now();
+
+      l_year = l_flag ? "9999" : connectPair( i_algo, l_id1, l_id2 );
+      l_line += l_year;
+
+      QueryStats l_pair = m_stats.since( l_before );
+      l_pair.m_micros   = std::chrono::duration< double, std::micro >( std::chrono::high_resolution_clock::now() - l_start ).count();
+      l_pair.m_targets  = 1;
+      logConnection( l_actor1, l_actor2, l_year, l_pair );
+    }
+
+    m_metrics.endPhase( "query", l_phase );
 
-    //! Try and find connection between the pair
-    if( !l_flag )
-      l_line += connectPair( i_algo, l_id1, l_id2 );
+    //! Write the line out (the sweep holds all lines until it is done)
+    if( i_algo == "sweep" )
+      l_sweepLines.push_back( l_line );
     else
-      l_line += "9999";
+      m_out.writeLine( l_line );
+
+    m_metrics.endPhase( "write", l_phase );
+  }
+
+  //! Connect all pairs at once and complete their lines
+  if( i_algo == "sweep" ) {
+    l_before = m_stats;
+    sweepPairs( l_sweepPairs, l_sweepYears );
+
+    //! The pairs share the work of the sweep, counted once in the totals
+    QueryStats l_sweep = m_stats.since( l_before );
+    l_sweep.m_micros   = std::chrono::duration< double, std::micro >( std::chrono::high_resolution_clock::now() - l_phase ).count();
+    l_sweep.m_targets  = (long long) l_sweepPairs.size();
+    m_metrics.addWork( l_sweep );
+
+    for( size_t l_p = 0; l_p < l_sweepPairs.size(); ++l_p ) {
+      l_sweepLines[l_sweepSlots[l_p]] += l_sweepYears[l_p];
+      logConnection( m_actorNames.name( l_sweepPairs[l_p].first ), m_actorNames.name( l_sweepPairs[l_p].second ),
+                     l_sweepYears[l_p], QueryStats() );
+    }
 
-    m_outLines.push_back( l_line );   //! Store line info to be written out later
+    m_metrics.endPhase( "query", l_phase );
+
+    for( size_t l_l = 0; l_l < l_sweepLines.size(); ++l_l )
+      m_out.writeLine( l_sweepLines[l_l] );
+
+    m_metrics.endPhase( "write", l_phase );
   }
 
   return true;
 }
 
+/** Input params: Query server, traversal algorithm
+ *  Return param: Boolean
+ *  Description : Serves actor connections
+ *
+ *  Answers each request with the year the actors got connected (9999 if
+ *  they never did). Requests come one at a time, so the sweep connects each
+ *  pair on its own like ufind; index answers without any pass over the
+ *  years. Each answered pair gets a metrics line, as in connectActors,
+ *  written out right away so a stopped server loses none.
+ */
+bool ActorConnect::serveConnections( QueryServer       &io_server,
+                                     const std::string &i_algo ) {
+  std::string l_algo = (i_algo == "sweep") ? "ufind" : i_algo;
+  std::string l_actor1, l_actor2;
+
+  startAlgorithm( i_algo );
+
+  return io_server.serve( [&]( const std::string &i_request, std::string &o_reply ) {
+    if( !QueryServer::splitPair( i_request, l_actor1, l_actor2 ) ) {
+      o_reply = "Expected actor1<TAB>actor2";
+      return false;
+    }
+
+    int l_id1 = findActor( l_actor1 );
+    int l_id2 = findActor( l_actor2 );
+    if( l_id1 == -1 || l_id2 == -1 ) {
+      o_reply = "Failure to locate node '" + (l_id1 == -1 ? l_actor1 : l_actor2) + "'";
+      return false;
+    }
+
+    QueryStats l_before = m_stats;
+    std::chrono::high_resolution_clock::time_point l_start;
+    l_start = std::chrono::high_resolution_clock::now();
+
+    o_reply = connectPair( l_algo, l_id1, l_id2 );
+
+    QueryStats l_pair = m_stats.since( l_before );
+    l_pair.m_micros   = std::chrono::duration< double, std::micro >( std::chrono::high_resolution_clock::now() - l_start ).count();
+    l_pair.m_targets  = 1;
+    logConnection( l_actor1, l_actor2, o_reply, l_pair );
+    m_metrics.flush();
+    return true;
+  } );
+}
+
 #endif //! UNIONFIND_HPP
\ No newline at end of file
@@ -0,0 +1,87 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Declaration of struct YearIndex, the movies of each year used to build the
+ * graph of actorconnections year by year.
+ **/
+
+#ifndef YEAR_INDEX_HPP
+#define YEAR_INDEX_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include "MovieTable.hpp"
+
+/** Movies grouped by year. The distinct years are m_years in ascending order
+ *  and the movies of year m_years[y] occupy
+ *  m_movieIds[m_offsets[y] .. m_offsets[y + 1]) (by id within a year), so
+ *  the credits added in a year are the casts of just those movies.
+ */
+struct YearIndex {
+  std::vector< int >  m_years;    //! Distinct years, ascending
+  std::vector< int >  m_offsets;  //! Movie offsets (size: years + 1)
+  std::vector< int >  m_movieIds; //! Movie-ids of all years
+
+  //! Number of distinct years
+  int numYears() const {
+    return (int) m_years.size();
+  }
+
+  bool empty() const {
+    return m_offsets.empty();
+  }
+
+  /** Input params: Interned movies
+   *  Return param: None
+   *  Description : Groups the movies by year (counting sort over the years)
+   */
+  void build( const MovieTable &i_movies ) {
+    std::vector< int > l_slot( i_movies.size() );  //! Position of each movie's year
+
+    m_years.assign( i_movies.m_years.data(), i_movies.m_years.end() );
+    std::sort( m_years.begin(), m_years.end() );
+    m_years.erase( std::unique( m_years.begin(), m_years.end() ), m_years.end() );
+
+    m_offsets.assign( m_years.size() + 1, 0 );
+    for( int l_movie = 0; l_movie < i_movies.size(); ++l_movie ) {
+      l_slot[l_movie] = (int) (std::lower_bound( m_years.begin(), m_years.end(), i_movies.m_years[l_movie] ) -
+                               m_years.begin());
+      ++m_offsets[l_slot[l_movie] + 1];
+    }
+
+    for( size_t l_y = 0; l_y < m_years.size(); ++l_y )
+      m_offsets[l_y + 1] += m_offsets[l_y];
+
+    std::vector< int > l_next( m_offsets.begin(), m_offsets.end() - 1 );  //! Next free position of each year
+    m_movieIds.resize( i_movies.size() );
+    for( int l_movie = 0; l_movie < i_movies.size(); ++l_movie )
+      m_movieIds[l_next[l_slot[l_movie]]++] = l_movie;
+  }
+};
+
+#endif //! YEAR_INDEX_HPP
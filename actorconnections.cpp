@@ -73,38 +73,96 @@ long long Timer::endTimer() {
 //! Main function
 int main( int i_argc, char** i_argv ) {
   //! Check input arguments
-  if( i_argc < 4 || i_argc > 5 ) {
+  if( i_argc < 4 ) {
     std::cout << "Invalid number of arguments.\n"
-              << "Usage: ./actorconnections movie_casts_file test_pairs_file out_file bfs/ufind\n";
+              << "Usage: ./actorconnections movie_casts_file test_pairs_file out_file bfs/dobfs/ufind/sweep/index [--stream] [--snapshot file] [--ids] [--metrics file]\n"
+              << "       ./actorconnections movie_casts_file --serve socket_path|- [bfs/dobfs/ufind/sweep/index] [options]\n";
     return EXIT_FAILURE;
   }
 
-  if( i_argc == 5 ) {
-    if( (strcmp( i_argv[4], "bfs" ) != 0) && (strcmp( i_argv[4], "ufind" ) != 0) ) {
-      std::cout << "Invalid last argument! Should be bfs/ufind.\n";
+  Timer l_tmr;                        //! Timer object
+  long long l_tt;                     //! Time (long long format)
+  std::string l_algorithm = "ufind";  //! Traversal algorithm (ufind if last arg missing)
+  bool l_stream = false;              //! Read cast file with getline (--stream)
+  const char *l_snapshot = NULL;      //! Graph snapshot to map or write (--snapshot)
+  bool l_ids = false;                 //! Output actor ids instead of names (--ids)
+  const char *l_serve = NULL;         //! Socket (or - for stdin) to serve pairs on instead of a file (--serve)
+  const char *l_metrics = NULL;       //! File to write a JSON line per pair and a summary to (--metrics)
+
+  //! Serve pairs instead of reading test_pairs_file and writing out_file
+  if( strcmp( i_argv[2], "--serve" ) == 0 )
+    l_serve = i_argv[3];
+
+  for( int l_i = 4; l_i < i_argc; ++l_i ) {
+    if( l_i == 4 && i_argv[l_i][0] != '-' ) {
+      if( (strcmp( i_argv[4], "bfs" ) != 0) && (strcmp( i_argv[4], "dobfs" ) != 0) &&
+          (strcmp( i_argv[4], "ufind" ) != 0) && (strcmp( i_argv[4], "sweep" ) != 0) &&
+          (strcmp( i_argv[4], "index" ) != 0) ) {
+        std::cout << "Invalid last argument! Should be bfs/dobfs/ufind/sweep/index.\n";
+        return EXIT_FAILURE;
+      }
+
+      l_algorithm = i_argv[4];
+    } else if( strcmp( i_argv[l_i], "--stream" ) == 0 )
+      l_stream = true;
+    else if( strcmp( i_argv[l_i], "--ids" ) == 0 )
+      l_ids = true;
+    else if( strcmp( i_argv[l_i], "--snapshot" ) == 0 && l_i + 1 < i_argc )
+      l_snapshot = i_argv[++l_i];
+    else if( strcmp( i_argv[l_i], "--metrics" ) == 0 && l_i + 1 < i_argc )
+      l_metrics = i_argv[++l_i];
+    else {
+      std::cout << "Invalid option " << i_argv[l_i] << "!\n";
       return EXIT_FAILURE;
     }
   }
 
-  Timer l_tmr;              //! Timer object
-  long long l_tt;           //! Time (long long format)
-  std::string l_algorithm;  //! Traversal algorithm
-
-  if( i_argc == 4 )
-    l_algorithm = "ufind";  //! By-default, ufind algorithm (if last arg missing)
-  else
-    l_algorithm = i_argv[4];
+  //! Listen before loading (with stdin, messages go to stderr from here on)
+  QueryServer l_server( l_serve != NULL ? l_serve : "-" );
+  if( l_serve != NULL && !l_server.open() )
+    return EXIT_FAILURE;
 
  //! ActorGraph object
   ActorConnect l_act( "Actor1\tActor2\tYear" );
 
-  //! Load the movie_casts_file
-  if( !l_act.loadFromFile( i_argv[1] ) )
+  //! Time the phases of the run (and log every pair if asked to)
+  std::chrono::high_resolution_clock::time_point l_phase = std::chrono::high_resolution_clock::now();
+  if( l_metrics != NULL && !l_act.openMetrics( l_metrics ) )
+    return EXIT_FAILURE;
+
+  //! Map the snapshot if there's an up-to-date one
+  bool l_mapped = (l_snapshot != NULL) && l_act.loadSnapshot( l_snapshot, i_argv[1] );
+
+  //! Otherwise load the movie_casts_file (memory-mapped unless asked otherwise)
+  if( !l_mapped && (l_stream ? !l_act.loadFromFile( i_argv[1] ) : !l_act.loadFromMappedFile( i_argv[1] )) )
     return EXIT_FAILURE;
 
+  l_act.endPhase( "load", l_phase );
+
   //! Create the graph with only actors as nodes (no edges)
   l_act.createGraph( false );
 
+  //! Build the connection index (unless the snapshot had it)
+  bool l_built = (l_algorithm == "index") && l_act.buildConnectionIndex();
+
+  //! Save what was built so that the next run can map it
+  if( l_snapshot != NULL && (!l_mapped || l_built) && !l_act.saveSnapshot( l_snapshot, i_argv[1] ) )
+    return EXIT_FAILURE;
+
+  l_act.endPhase( "build", l_phase );
+
+  //! Or answer pairs as they come
+  if( l_serve != NULL ) {
+    bool l_served = l_act.serveConnections( l_server, l_algorithm );
+    l_act.endPhase( "serve", l_phase );
+
+    return (l_act.closeMetrics() && l_served) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  //! Open the output file, written to as pairs are connected
+  if( !l_act.openOutput( i_argv[3], l_ids ) )
+    return EXIT_FAILURE;
+
   //! Note begin time
   l_tmr.beginTimer();
 
@@ -116,8 +174,8 @@ int main( int i_argc, char** i_argv ) {
   l_tt = l_tmr.endTimer();
   std::cout << "Run time = " << l_tt / 1e9 << "sec\n";
 
-  //! Write final output to file
-  if( !l_act.writeOutLines( i_argv[3] ) )
+  //! Write the rest of the output to file
+  if( !l_act.closeOutput() || !l_act.closeMetrics() )
     return EXIT_FAILURE;
 
   return EXIT_SUCCESS;
@@ -0,0 +1,174 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of castgen program, writing a synthetic IMDB-like movie
+ * cast file for benchmarks.
+ **/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "OutputWriter.h"
+#include "SplitMix64.hpp"
+
+//! Cast sizes follow a Pareto law of this exponent (heavier tail when smaller)
+static const double g_castExponent = 1.6;
+
+//! Smallest and largest cast
+static const int g_minCast = 2;
+static const int g_maxCast = 400;
+
+//! Actors are picked with weight 1 / rank^g_actorExponent (power-law filmographies)
+static const double g_actorExponent = 0.85;
+
+//! Actors of test_pairs.tsv, given the most movies so the pairs file works on any generated file
+static const char *g_knownActors[] = { "BACON, KEVIN (I)", "HOUNSOU, DJIMON", "KIDMAN, NICOLE",
+                                       "WILLIS, BRUCE", "GIAMATTI, PAUL", "50 CENT" };
+
+/** Input params: Actor rank
+ *  Return param: Actor name
+ *  Description : Names an actor
+ */
+static std::string actorName( const int &i_rank ) {
+  int l_known = (int) (sizeof( g_knownActors ) / sizeof( g_knownActors[0] ));
+
+  if( i_rank < l_known )
+    return g_knownActors[i_rank];
+
+  return "ACTOR " + std::to_string( i_rank ) + ", X";
+}
+
+//! Main function
+int main( int i_argc, char** i_argv ) {
+  if( i_argc < 2 ) {
+    std::cout << "Invalid number of arguments.\n"
+              << "Usage: ./castgen out_file [actors] [movies] [first_year] [last_year] [seed]\n";
+    return EXIT_FAILURE;
+  }
+
+  int l_numActors = (i_argc > 2) ? atoi( i_argv[2] ) : 100000;  //! Actors to pick casts from
+  int l_numMovies = (i_argc > 3) ? atoi( i_argv[3] ) : 50000;   //! Movies
+  int l_firstYear = (i_argc > 4) ? atoi( i_argv[4] ) : 1950;    //! Years of the movies
+  int l_lastYear  = (i_argc > 5) ? atoi( i_argv[5] ) : 2015;
+  uint64_t l_seed = (i_argc > 6) ? strtoull( i_argv[6], NULL, 10 ) : 1;
+
+  if( l_numActors < g_minCast || l_numMovies < 1 || l_lastYear < l_firstYear ) {
+    std::cout << "Invalid sizes or years!\n";
+    return EXIT_FAILURE;
+  }
+
+  SplitMix64 l_rng( l_seed );
+
+  //! Cumulative pick weight of the actors by rank
+  std::vector< double > l_weights( l_numActors );
+  double l_total = 0;
+  for( int l_rank = 0; l_rank < l_numActors; ++l_rank ) {
+    l_total += 1.0 / std::pow( l_rank + 1.0, g_actorExponent );
+    l_weights[l_rank] = l_total;
+  }
+
+  std::vector< int >  l_years( l_numMovies );     //! Year of each movie
+  std::vector< int >  l_credits;                  //! < movie, actor > of every credit, flattened
+  std::vector< int >  l_lastMovie( l_numActors, -1 );  //! Last movie an actor was cast in
+
+  for( int l_movie = 0; l_movie < l_numMovies; ++l_movie ) {
+    //! More movies in later years (the density of the year grows linearly)
+    l_years[l_movie] = l_firstYear + (int) ((l_lastYear - l_firstYear + 1) * std::sqrt( l_rng.uniform() ));
+
+    //! Pareto cast size, capped
+    double l_size = g_minCast / std::pow( 1.0 - l_rng.uniform(), 1.0 / g_castExponent );
+    int    l_cast = (int) std::min( l_size, (double) std::min( g_maxCast, l_numActors ) );
+
+    for( int l_c = 0; l_c < l_cast; ++l_c ) {
+      int l_actor;
+
+      //! Draw again if already in the cast
+      do {
+        l_actor = (int) (std::upper_bound( l_weights.begin(), l_weights.end(), l_rng.uniform() * l_total ) -
+                         l_weights.begin());
+        l_actor = std::min( l_actor, l_numActors - 1 );
+      } while( l_lastMovie[l_actor] == l_movie );
+
+      l_lastMovie[l_actor] = l_movie;
+      l_credits.push_back( l_movie );
+      l_credits.push_back( l_actor );
+    }
+  }
+
+  //! Group the credits by actor, like the IMDB file (counting sort, movies in order)
+  std::vector< int > l_offsets( l_numActors + 1, 0 );
+  for( size_t l_k = 1; l_k < l_credits.size(); l_k += 2 )
+    ++l_offsets[l_credits[l_k] + 1];
+
+  for( int l_actor = 0; l_actor < l_numActors; ++l_actor )
+    l_offsets[l_actor + 1] += l_offsets[l_actor];
+
+  std::vector< int > l_filmographies( l_credits.size() / 2 );
+  std::vector< int > l_fill( l_offsets.begin(), l_offsets.end() - 1 );
+  for( size_t l_k = 0; l_k < l_credits.size(); l_k += 2 )
+    l_filmographies[l_fill[l_credits[l_k + 1]]++] = l_credits[l_k];
+
+  OutputWriter l_out;
+  if( !l_out.open( i_argv[1] ) ) {
+    std::cerr << "Failed to open " << i_argv[1] << "!\n";
+    return EXIT_FAILURE;
+  }
+
+  l_out.writeLine( std::string( "Actor/Actress\tMovie\tYear" ) );
+
+  int         l_numCredited = 0;
+  std::string l_line, l_name;
+  for( int l_actor = 0; l_actor < l_numActors; ++l_actor ) {
+    if( l_offsets[l_actor] == l_offsets[l_actor + 1] )
+      continue;
+
+    ++l_numCredited;
+    l_name = actorName( l_actor );
+
+    for( int l_k = l_offsets[l_actor]; l_k < l_offsets[l_actor + 1]; ++l_k ) {
+      int l_movie = l_filmographies[l_k];
+
+      l_line = l_name + "\tMOVIE " + std::to_string( l_movie ) + "\t" + std::to_string( l_years[l_movie] );
+      l_out.writeLine( l_line );
+    }
+  }
+
+  if( !l_out.close() ) {
+    std::cerr << "Failed to write " << i_argv[1] << "!\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Wrote " << l_credits.size() / 2 << " credits of " << l_numCredited << " actors in "
+            << l_numMovies << " movies (" << l_firstYear << "-" << l_lastYear << ") to " << i_argv[1]
+            << ", " << l_out.numBytes() / (1024.0 * 1024.0) << " MB\n";
+
+  return EXIT_SUCCESS;
+}
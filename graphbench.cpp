@@ -0,0 +1,331 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of graphbench program, timing the loading, graph creation,
+ * traversals and actor connections on a movie cast file.
+ **/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <algorithm>
+#include <thread>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "SplitMix64.hpp"
+#include "UnionFind.hpp"
+
+//! A benchmark's result
+struct BenchResult {
+  std::string m_name;     //! What was timed
+  double      m_secs;     //! Time taken
+  double      m_count;    //! Units processed
+  std::string m_unit;     //! Their name
+  double      m_deltaMB;  //! Growth of the RSS over the benchmark (negative if it shrank)
+  double      m_peakMB;   //! Peak RSS of the program so far, over all benchmarks run
+};
+
+//! Results in the order they were run
+static std::vector< BenchResult > g_results;
+
+//! RSS when the current benchmark started (MB)
+static double g_startMB = 0;
+
+/** Input params: None
+ *  Return param: Peak resident set size of the program so far (MB)
+ *  Description : Reads the peak RSS
+ */
+static double peakRSS() {
+  rusage l_usage;
+  getrusage( RUSAGE_SELF, &l_usage );
+
+  return l_usage.ru_maxrss / 1024.0;    //! Linux reports KB
+}
+
+/** Input params: None
+ *  Return param: Resident set size of the program now (MB)
+ *  Description : Reads the current RSS from /proc/self/statm
+ */
+static double currentRSS() {
+  long  l_size = 0, l_resident = 0;
+  FILE *l_statm = std::fopen( "/proc/self/statm", "r" );
+
+  if( l_statm == NULL )
+    return 0;
+
+  if( std::fscanf( l_statm, "%ld %ld", &l_size, &l_resident ) != 2 )
+    l_resident = 0;
+  std::fclose( l_statm );
+
+  return l_resident * (double) sysconf( _SC_PAGESIZE ) / (1024.0 * 1024.0);
+}
+
+/** Input params: None
+ *  Return param: Start time of a benchmark
+ *  Description : Starts a benchmark (noting the RSS it starts from)
+ */
+static std::chrono::high_resolution_clock::time_point startBench() {
+  g_startMB = currentRSS();
+
+  return std::chrono::high_resolution_clock::now();
+}
+
+/** Input params: Two arrays
+ *  Return param: Same elements or not
+ *  Description : Compares two arrays element by element
+ */
+template< class T >
+static bool sameArray( const MappedArray< T > &i_a,
+                       const MappedArray< T > &i_b ) {
+  return i_a.size() == i_b.size() && std::equal( i_a.data(), i_a.end(), i_b.data() );
+}
+
+/** Input params: Benchmark name, start time (from startBench), units
+ *                processed and their name
+ *  Return param: None
+ *  Description : Records a benchmark's result
+ */
+static void record( const std::string                                    &i_name,
+                    const std::chrono::high_resolution_clock::time_point &i_start,
+                    const double                                         &i_count,
+                    const std::string                                    &i_unit ) {
+  BenchResult l_result;
+
+  l_result.m_name   = i_name;
+  l_result.m_secs   = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - i_start ).count();
+  l_result.m_count  = i_count;
+  l_result.m_unit    = i_unit;
+  l_result.m_deltaMB = currentRSS() - g_startMB;
+  l_result.m_peakMB  = peakRSS();
+
+  g_results.push_back( l_result );
+}
+
+//! ActorGraph running single-pair searches
+class TraversalBench : public ActorGraph {
+public:
+  //! Constructor
+  TraversalBench( const std::string &i_uwe ) : ActorGraph( "", i_uwe ) {}
+
+  //! Number of actors
+  int numActors() const {
+    return m_actorNames.size();
+  }
+
+  //! Number of co-star edges
+  size_t numEdges() const {
+    return m_csr.numEdges();
+  }
+
+  //! Same CSR adjacency as another graph or not
+  bool sameAdjacency( const TraversalBench &i_other ) const {
+    return sameArray( m_csr.m_offsets, i_other.m_csr.m_offsets ) &&
+           sameArray( m_csr.m_neighbors, i_other.m_csr.m_neighbors ) &&
+           sameArray( m_csr.m_weights, i_other.m_csr.m_weights ) &&
+           sameArray( m_csr.m_movies, i_other.m_csr.m_movies );
+  }
+
+  //! Search each pair on its own (returns the actors visited)
+  long long searchPairs( const std::vector< std::pair< int, int > > &i_pairs ) const {
+    TraversalState                    l_state;
+    std::vector< int >                l_targets( 1 );
+    std::vector< std::vector< int > > l_paths;
+
+    l_state.init( m_actorNames.size(), m_movieTable.size() );
+    l_state.m_bucketQueue.init( std::max( m_maxWeight, 0 ) );
+
+    for( const std::pair< int, int > &l_pair : i_pairs ) {
+      l_targets[0] = l_pair.second;
+      findPaths( l_pair.first, l_targets, l_state, l_paths );
+    }
+
+    return l_state.m_numVisited;
+  }
+};
+
+//! ActorConnect connecting pairs one at a time
+class ConnectBench : public ActorConnect {
+public:
+  //! Constructor
+  ConnectBench() : ActorConnect( "" ) {}
+
+  //! Number of actors
+  int numActors() const {
+    return m_actorNames.size();
+  }
+
+  //! Connect each pair (returns the pairs that got connected)
+  int connectPairs( const std::string                          &i_algo,
+                    const std::vector< std::pair< int, int > > &i_pairs ) {
+    int l_connected = 0;
+
+    extractYearsInAscOrder();
+    for( const std::pair< int, int > &l_pair : i_pairs )
+      l_connected += (connectPair( i_algo, l_pair.first, l_pair.second ) != "9999");
+
+    return l_connected;
+  }
+};
+
+/** Input params: Number of actors and pairs, seed, pairs (passed by reference)
+ *  Return param: None
+ *  Description : Draws random actor pairs
+ */
+static void drawPairs( const int                                  &i_numActors,
+                       const int                                  &i_count,
+                       const uint64_t                             &i_seed,
+                             std::vector< std::pair< int, int > > &o_pairs ) {
+  SplitMix64 l_rng( i_seed );
+
+  o_pairs.clear();
+  for( int l_p = 0; l_p < i_count; ++l_p ) {
+    int l_from = l_rng.below( i_numActors );
+    o_pairs.push_back( std::make_pair( l_from, l_rng.below( i_numActors ) ) );
+  }
+}
+
+//! Main function
+int main( int i_argc, char** i_argv ) {
+  if( i_argc < 2 ) {
+    std::cout << "Invalid number of arguments.\n"
+              << "Usage: ./graphbench movie_casts_file [pairs] [ufind_pairs] [bfs_pairs] [threads]\n";
+    return EXIT_FAILURE;
+  }
+
+  int l_numPairs = (i_argc > 2) ? atoi( i_argv[2] ) : 200;  //! Pairs searched by the traversals
+  int l_numUFind = (i_argc > 3) ? atoi( i_argv[3] ) : 200;  //! Pairs connected by ufind
+  int l_numBFS   = (i_argc > 4) ? atoi( i_argv[4] ) : 4;    //! Pairs connected by bfs (a BFS per year each)
+  int l_threads  = (i_argc > 5) ? atoi( i_argv[5] ) : 0;    //! Most threads building the graph
+
+  if( l_threads <= 0 )
+    l_threads = std::max( (int) std::thread::hardware_concurrency(), 1 );
+
+  //! Size of the file (throughput of the loads)
+  std::ifstream l_file( i_argv[1], std::ios::binary | std::ios::ate );
+  double l_fileMB = l_file ? l_file.tellg() / (1024.0 * 1024.0) : 0;
+  l_file.close();
+
+  std::vector< std::pair< int, int > > l_pairs;
+  std::chrono::high_resolution_clock::time_point l_start;
+
+  //! Loading the file, line by line and mapped
+  {
+    TraversalBench l_graph( "u" );
+
+    l_start = startBench();
+    if( !l_graph.loadFromFile( i_argv[1] ) )
+      return EXIT_FAILURE;
+    record( "loadFromFile", l_start, l_fileMB, "MB" );
+  }
+
+  for( const char *l_mode : { "u", "w" } ) {
+    TraversalBench l_graph( l_mode );
+
+    l_start = startBench();
+    if( !l_graph.loadFromMappedFile( i_argv[1] ) )
+      return EXIT_FAILURE;
+    record( std::string( "loadFromMappedFile " ) + l_mode, l_start, l_fileMB, "MB" );
+
+    l_start = startBench();
+    if( !l_graph.createGraph() )
+      return EXIT_FAILURE;
+    record( std::string( "createGraph " ) + l_mode, l_start, l_graph.numEdges(), "edges" );
+
+    //! createGraph on 2, 4, ... threads up to l_threads, checked against the serial build
+    for( int l_t = 2; l_t < 2 * l_threads; l_t *= 2 ) {
+      TraversalBench l_parallel( l_mode );
+      int            l_numThreads = std::min( l_t, l_threads );
+
+      if( !l_parallel.loadFromMappedFile( i_argv[1] ) )
+        return EXIT_FAILURE;
+
+      l_start = startBench();
+      if( !l_parallel.createGraph( true, l_numThreads ) )
+        return EXIT_FAILURE;
+      record( std::string( "createGraph " ) + l_mode + " (" + std::to_string( l_numThreads ) + " thr)",
+              l_start, l_parallel.numEdges(), "edges" );
+
+      if( !l_parallel.sameAdjacency( l_graph ) ) {
+        std::cerr << "Graph built on " << l_numThreads << " threads differs from the serial one\n";
+        return EXIT_FAILURE;
+      }
+      std::cout << "Graph built on " << l_numThreads << " threads matches the serial one\n";
+    }
+
+    drawPairs( l_graph.numActors(), l_numPairs, 1, l_pairs );
+
+    //! BFSTraverse for u, DjikstraTraverse with Dial's buckets and with the binary heap for w
+    for( const char *l_search : { "", "dijkstra" } ) {
+      if( l_mode == std::string( "u" ) && *l_search != '\0' )
+        continue;
+
+      l_graph.useSearch( l_search );
+
+      l_start = startBench();
+      long long l_visited = l_graph.searchPairs( l_pairs );
+      record( l_mode == std::string( "u" ) ? "BFSTraverse" :
+              (*l_search == '\0' ? "DjikstraTraverse (dial)" : "DjikstraTraverse (heap)"),
+              l_start, (double) l_visited, "visits" );
+      std::cout << "Searched " << l_pairs.size() << " pairs, " << (double) l_visited / l_pairs.size()
+                << " actors visited per pair\n";
+    }
+  }
+
+  //! Connecting pairs year by year
+  for( const char *l_algo : { "ufind", "bfs" } ) {
+    ConnectBench l_connect;
+
+    if( !l_connect.loadFromMappedFile( i_argv[1] ) )
+      return EXIT_FAILURE;
+    l_connect.createGraph( false );
+
+    drawPairs( l_connect.numActors(), l_algo == std::string( "bfs" ) ? l_numBFS : l_numUFind, 2, l_pairs );
+
+    l_start = startBench();
+    int l_connected = l_connect.connectPairs( l_algo, l_pairs );
+    record( std::string( "connectPair " ) + l_algo, l_start, l_pairs.size(), "pairs" );
+    std::cout << "Connected " << l_connected << " of " << l_pairs.size() << " pairs\n";
+  }
+
+  std::cout << "\n" << std::left << std::setw( 26 ) << "benchmark" << std::right << std::setw( 12 ) << "time (ms)"
+            << std::setw( 22 ) << "throughput" << std::setw( 16 ) << "RSS delta (MB)"
+            << std::setw( 30 ) << "process peak RSS so far (MB)" << "\n";
+  for( const BenchResult &l_result : g_results )
+    std::cout << std::left << std::setw( 26 ) << l_result.m_name << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 12 ) << l_result.m_secs * 1e3
+              << std::setw( 14 ) << l_result.m_count / std::max( l_result.m_secs, 1e-9 ) << " " << std::left
+              << std::setw( 7 ) << (l_result.m_unit + "/s") << std::right
+              << std::setw( 16 ) << l_result.m_deltaMB
+              << std::setw( 30 ) << l_result.m_peakMB << "\n";
+
+  return EXIT_SUCCESS;
+}
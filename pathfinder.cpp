@@ -34,34 +34,150 @@ int main( int i_argc, char** i_argv ) {
   //! Start time
   clock_t l_t   = clock();
 
+  bool l_bipartite = false;  //! Traverse actor-movie graph (--bipartite)
+  bool l_stream    = false;  //! Read cast file with getline (--stream)
+  const char *l_snapshot = NULL;  //! Graph snapshot to map or write (--snapshot)
+  int  l_threads   = 1;      //! Threads searching the pairs (--threads, 0 = all)
+  std::string l_search;      //! Search algorithm (--search, default of u/w if empty)
+  int  l_landmarks = 16;     //! Landmarks of A* traversal (--landmarks)
+  bool l_ids       = false;  //! Output actor/movie ids instead of names (--ids)
+  int  l_cache     = 0;      //! Paths kept for repeated pairs (--cache, 0 = none)
+  int  l_hubs      = 0;      //! Top-degree actors with shortest-path trees (--hubs, 0 = none)
+  const char *l_hubList  = NULL;  //! File listing the hub actors (--hub-list)
+  const char *l_hubTable = NULL;  //! File to write every actor's hub distances to (--hub-table)
+  const char *l_serve    = NULL;  //! Socket (or - for stdin) to serve pairs on instead of a file (--serve)
+  const char *l_metrics  = NULL;  //! File to write a JSON line per pair and a summary to (--metrics)
+
   //! Check input arguments
-  if( i_argc != 5 ) {
+  if( i_argc < 5 ) {
     std::cout << "Invalid number of arguments.\n"
-              << "Usage: ./pathfinder movie_casts_file u/w test_pairs_file out_file\n";
+              << "Usage: ./pathfinder movie_casts_file u/w test_pairs_file out_file [--bipartite] [--stream] [--snapshot file] [--threads n] [--search name] [--landmarks n] [--ids] [--cache n] [--hubs n] [--hub-list file] [--hub-table file] [--metrics file]\n"
+              << "       ./pathfinder movie_casts_file u/w --serve socket_path|- [options]\n";
     return EXIT_FAILURE;
   }
 
+  //! Serve pairs instead of reading test_pairs_file and writing out_file
+  if( strcmp( i_argv[3], "--serve" ) == 0 )
+    l_serve = i_argv[4];
+
+  //! Optional arguments
+  for( int l_i = 5; l_i < i_argc; ++l_i ) {
+    if( strcmp( i_argv[l_i], "--bipartite" ) == 0 )
+      l_bipartite = true;
+    else if( strcmp( i_argv[l_i], "--stream" ) == 0 )
+      l_stream = true;
+    else if( strcmp( i_argv[l_i], "--ids" ) == 0 )
+      l_ids = true;
+    else if( strcmp( i_argv[l_i], "--snapshot" ) == 0 && l_i + 1 < i_argc )
+      l_snapshot = i_argv[++l_i];
+    else if( strcmp( i_argv[l_i], "--threads" ) == 0 && l_i + 1 < i_argc )
+      l_threads = atoi( i_argv[++l_i] );
+    else if( strcmp( i_argv[l_i], "--search" ) == 0 && l_i + 1 < i_argc )
+      l_search = i_argv[++l_i];
+    else if( strcmp( i_argv[l_i], "--landmarks" ) == 0 && l_i + 1 < i_argc && atoi( i_argv[l_i + 1] ) > 0 )
+      l_landmarks = atoi( i_argv[++l_i] );
+    else if( strcmp( i_argv[l_i], "--cache" ) == 0 && l_i + 1 < i_argc && atoi( i_argv[l_i + 1] ) >= 0 )
+      l_cache = atoi( i_argv[++l_i] );
+    else if( strcmp( i_argv[l_i], "--hubs" ) == 0 && l_i + 1 < i_argc && atoi( i_argv[l_i + 1] ) >= 0 )
+      l_hubs = atoi( i_argv[++l_i] );
+    else if( strcmp( i_argv[l_i], "--hub-list" ) == 0 && l_i + 1 < i_argc )
+      l_hubList = i_argv[++l_i];
+    else if( strcmp( i_argv[l_i], "--hub-table" ) == 0 && l_i + 1 < i_argc )
+      l_hubTable = i_argv[++l_i];
+    else if( strcmp( i_argv[l_i], "--metrics" ) == 0 && l_i + 1 < i_argc )
+      l_metrics = i_argv[++l_i];
+    else {
+      std::cout << "Invalid option " << i_argv[l_i] << "!\n";
+      return EXIT_FAILURE;
+    }
+  }
+
   if( (strcmp( i_argv[2], "u" ) != 0) && (strcmp( i_argv[2], "w" ) != 0) ) {
     std::cout << "Invalid second argument! Should be u/w.\n";
     return EXIT_FAILURE;
   }
 
+  //! Searches available for unweighted (bfs, bidir, dobfs), weighted (dial, dijkstra) and both (astar) traversal
+  bool l_unweighted = (strcmp( i_argv[2], "u" ) == 0);
+  if( !l_search.empty() &&
+      !(l_unweighted && (l_search == "bfs" || ((l_search == "bidir" || l_search == "dobfs") && !l_bipartite))) &&
+      !(!l_unweighted && (l_search == "dial" || l_search == "dijkstra")) &&
+      !(l_search == "astar" && !l_bipartite) ) {
+    std::cout << "Invalid search " << l_search << " for " << i_argv[2]
+              << (l_bipartite ? " --bipartite" : "") << "!\n";
+    return EXIT_FAILURE;
+  }
+
+  //! Listen before loading (with stdin, messages go to stderr from here on)
+  QueryServer l_server( l_serve != NULL ? l_serve : "-" );
+  if( l_serve != NULL && !l_server.open() )
+    return EXIT_FAILURE;
+
  //! ActorGraph object
   ActorGraph l_act( "(actor)--[movie#@year]-->(actor)--...", i_argv[2] );
 
-  //! Load the movie_casts_file
-  if( !l_act.loadFromFile( i_argv[1] ) )
+  //! Time the phases of the run (and log every pair if asked to)
+  std::chrono::high_resolution_clock::time_point l_phase = std::chrono::high_resolution_clock::now();
+  if( l_metrics != NULL && !l_act.openMetrics( l_metrics ) )
+    return EXIT_FAILURE;
+
+  //! Map the snapshot if there's an up-to-date one
+  bool l_mapped = (l_snapshot != NULL) && l_act.loadSnapshot( l_snapshot, i_argv[1] );
+
+  //! Otherwise load the movie_casts_file (memory-mapped unless asked otherwise)
+  if( !l_mapped && (l_stream ? !l_act.loadFromFile( i_argv[1] ) : !l_act.loadFromMappedFile( i_argv[1] )) )
+    return EXIT_FAILURE;
+
+  l_act.endPhase( "load", l_phase );
+
+  //! Create the graph with actors as nodes and movies as edges (or nodes)
+  l_act.useBipartite( l_bipartite );
+  l_act.useSearch( l_search );
+  l_act.useCache( l_cache );
+  if( !l_act.createGraph( true, l_threads ) )
     return EXIT_FAILURE;
 
-  //! Create the graph with actors as nodes and movies as edges
-  l_act.createGraph();
+  //! Compute the landmarks of A* traversal (unless the snapshot had them)
+  bool l_built = (l_search == "astar") && l_act.buildLandmarks( l_landmarks );
+
+  //! A co-star adjacency the snapshot lacked (e.g. of the other of u/w) is saved too
+  l_built = l_act.builtCSR() || l_built;
+
+  //! Save what was built so that the next run can map it
+  if( l_snapshot != NULL && (!l_mapped || l_built) && !l_act.saveSnapshot( l_snapshot, i_argv[1] ) )
+    return EXIT_FAILURE;
+
+  //! Open the output file, written to as paths are found
+  l_act.useIds( l_ids );
+  if( l_serve == NULL && !l_act.openOutput( i_argv[4], l_ids ) )
+    return EXIT_FAILURE;
+
+  //! Compute the shortest-path trees of the hubs (the top-degree actor if only the table is asked for)
+  if( l_hubTable != NULL && l_hubs == 0 && l_hubList == NULL )
+    l_hubs = 1;
+
+  if( (l_hubs > 0 || l_hubList != NULL) && !l_act.buildHubs( l_hubs, l_hubList, l_threads ) )
+    return EXIT_FAILURE;
+
+  if( l_hubTable != NULL && !l_act.writeHubTable( l_hubTable, l_threads ) )
+    return EXIT_FAILURE;
+
+  l_act.endPhase( "build", l_phase );
+
+  //! Or answer pairs as they come
+  if( l_serve != NULL ) {
+    bool l_served = l_act.servePairs( l_server );
+    l_act.endPhase( "serve", l_phase );
+
+    return (l_act.closeMetrics() && l_served) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
 
   //! Load actor pairs from input file and perform path find operations
-  if( !l_act.loadTestPairs( i_argv[3] ) )
+  if( !l_act.loadTestPairs( i_argv[3], l_threads ) )
     return EXIT_FAILURE;
 
-  //! Write final output to file
-  if( !l_act.writeOutLines( i_argv[4] ) )
+  //! Write the rest of the output to file
+  if( !l_act.closeOutput() || !l_act.closeMetrics() )
     return EXIT_FAILURE;
 
   //! Finish time
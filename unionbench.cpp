@@ -0,0 +1,136 @@
+/**
+ * @file This file is part of SixDegreesOfKevinBacon.
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2018 Rajdeep Konwar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Implementation of unionbench program, timing the union and compression
+ * policies of DisjointSet on the union sequence of actorconnections.
+ **/
+
+#include <chrono>
+#include <iostream>
+
+#include "UnionFind.hpp"
+
+//! ActorConnect handing out the unions of its union-find sweep
+class UnionSequence : public ActorConnect {
+public:
+  //! Constructor
+  UnionSequence() : ActorConnect( "" ) {}
+
+  //! Actor pairs united by the sweep, movies in year order
+  void listUnions( std::vector< std::pair< int, int > > &o_unions ) {
+    extractYearsInAscOrder();
+
+    for( size_t l_m = 0; l_m < m_yearIndex.m_movieIds.size(); ++l_m ) {
+      int l_movie = m_yearIndex.m_movieIds[l_m];
+
+      for( int l_c = m_bip.m_castOffsets[l_movie] + 1; l_c < m_bip.m_castOffsets[l_movie + 1]; ++l_c )
+        o_unions.push_back( std::make_pair( m_bip.m_castIds[m_bip.m_castOffsets[l_movie]], m_bip.m_castIds[l_c] ) );
+    }
+  }
+
+  //! Number of actors
+  int numActors() const {
+    return m_actorNames.size();
+  }
+};
+
+/** Input params: Policy name, unions, number of actors and repetitions
+ *  Return param: None
+ *  Description : Time a policy
+ *
+ *  Replays the unions (each one 2 finds and at most 1 link) on a fresh
+ *  DisjointSet i_repeats times, then finds every actor once, and prints the
+ *  best time per operation.
+ */
+template< class UnionPolicy, class CompressionPolicy >
+void timePolicy( const std::string                          &i_name,
+                 const std::vector< std::pair< int, int > > &i_unions,
+                 const int                                  &i_numActors,
+                 const int                                  &i_repeats ) {
+  DisjointSet< int, UnionPolicy, CompressionPolicy > l_sets;
+  double    l_best   = 0;   //! Fastest run in seconds
+  long long l_merged = 0;   //! Unions that joined 2 sets (same in every run)
+  long long l_roots  = 0;   //! Sum of the final roots (keeps the finds alive)
+
+  for( int l_r = 0; l_r < i_repeats; ++l_r ) {
+    l_sets.reset( i_numActors );
+    l_merged = 0;
+    l_roots  = 0;
+
+    std::chrono::high_resolution_clock::time_point l_start;
+    l_start = std::chrono::high_resolution_clock::now();
+
+    for( size_t l_u = 0; l_u < i_unions.size(); ++l_u )
+      l_merged += l_sets.unite( i_unions[l_u].first, i_unions[l_u].second );
+
+    for( int l_index = 0; l_index < i_numActors; ++l_index )
+      l_roots += l_sets.find( l_index );
+
+    double l_secs = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - l_start ).count();
+    if( l_r == 0 || l_secs < l_best )
+      l_best = l_secs;
+  }
+
+  std::cout << i_name << "\t" << l_best * 1e3 << " ms\t"
+            << l_best * 1e9 / (i_unions.size() + i_numActors) << " ns/op\t"
+            << l_merged << " merges\t(" << l_roots << ")\n";
+}
+
+//! Main function
+int main( int i_argc, char** i_argv ) {
+  if( i_argc < 2 ) {
+    std::cout << "Invalid number of arguments.\n"
+              << "Usage: ./unionbench movie_casts_file [repeats]\n";
+    return EXIT_FAILURE;
+  }
+
+  int l_repeats = (i_argc > 2) ? atoi( i_argv[2] ) : 5;  //! Runs per policy (best one counts)
+  if( l_repeats < 1 )
+    l_repeats = 1;
+
+  UnionSequence l_seq;
+  if( !l_seq.loadFromMappedFile( i_argv[1] ) )
+    return EXIT_FAILURE;
+
+  l_seq.createGraph( false );
+
+  std::vector< std::pair< int, int > > l_unions;
+  l_seq.listUnions( l_unions );
+  std::cout << l_unions.size() << " unions over " << l_seq.numActors() << " actors, best of "
+            << l_repeats << " runs\n";
+
+  timePolicy< UnionBySize, PathHalving >(     "size+halving",     l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionBySize, PathSplitting >(   "size+splitting",   l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionBySize, FullCompression >( "size+compression", l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionBySize, NoCompression >(   "size+none",        l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionByRank, PathHalving >(     "rank+halving",     l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionByRank, PathSplitting >(   "rank+splitting",   l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionByRank, FullCompression >( "rank+compression", l_unions, l_seq.numActors(), l_repeats );
+  timePolicy< UnionByRank, NoCompression >(   "rank+none",        l_unions, l_seq.numActors(), l_repeats );
+
+  return EXIT_SUCCESS;
+}